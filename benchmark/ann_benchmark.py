@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""
+ANN benchmark for the HNSW index of the vss extension.
+
+Builds an index over a locally generated (uniform or clustered) or fvecs-loaded dataset and
+reports the build time, the approximate memory usage of the index, and recall@k and queries
+per second at several hnsw_ef_search values. The ground truth is computed with an exact scan
+before the index is created, unless it is supplied as an ivecs file.
+
+Examples:
+    python3 benchmark/ann_benchmark.py --dims 128,768 --distribution uniform,clustered
+    python3 benchmark/ann_benchmark.py --base sift_base.fvecs --queries sift_query.fvecs \
+        --groundtruth sift_groundtruth.ivecs
+"""
+
+import argparse
+import csv
+import sys
+import time
+
+import duckdb
+
+DEFAULT_EXTENSION = 'build/release/extension/vss/vss.duckdb_extension'
+
+# The distance function used by each metric, and whether the index orders by the
+# largest (similarity) or the smallest (distance) value of that function
+METRIC_FUNCTIONS = {
+    'l2sq': ('array_distance', False),
+    'cosine': ('array_cosine_similarity', True),
+    'ip': ('array_inner_product', True),
+}
+
+# Vectors are drawn uniformly from a box of width spread around a number of random centers,
+# a single cluster gives a uniform distribution
+DISTRIBUTIONS = {
+    'uniform': (1, 2.0),
+    'clustered': (64, 0.1),
+}
+
+
+def parse_int_list(value):
+    return [int(v) for v in value.split(',') if v]
+
+
+def parse_str_list(value):
+    return [v for v in value.split(',') if v]
+
+
+def connect(args):
+    con = duckdb.connect(config={'allow_unsigned_extensions': 'true'})
+    con.execute(f"LOAD '{args.extension}'")
+    if args.threads:
+        con.execute(f"SET threads = {args.threads}")
+    return con
+
+
+def generate_dataset(con, dims, rows, queries, distribution, seed):
+    clusters, spread = DISTRIBUTIONS[distribution]
+    con.execute(f"SELECT setseed({seed})")
+    con.execute(
+        f"CREATE TABLE centroids AS SELECT c AS cid, list_transform(range({dims}), x -> random()::FLOAT) AS center "
+        f"FROM range({clusters}) r(c)"
+    )
+    for table, count in (('vectors', rows), ('queries', queries)):
+        con.execute(
+            f"CREATE TABLE {table} AS SELECT i AS id, "
+            f"list_transform(center, x -> (x + (random() - 0.5) * {spread})::FLOAT)::FLOAT[{dims}] AS vec "
+            f"FROM range({count}) r(i) JOIN centroids ON cid = i % {clusters}"
+        )
+    con.execute("DROP TABLE centroids")
+
+
+def load_dataset(con, args):
+    # bvecs components are converted to floats, which the index requires
+    reader = 'read_bvecs' if args.base.endswith('.bvecs') else 'read_fvecs'
+    dims = con.execute(f"SELECT len(vec) FROM {reader}('{args.base}') LIMIT 1").fetchone()[0]
+    rows = f" WHERE id < {args.rows}" if args.rows else ""
+    con.execute(f"CREATE TABLE vectors AS SELECT id, vec::FLOAT[{dims}] AS vec FROM {reader}('{args.base}'){rows}")
+    con.execute(
+        f"CREATE TABLE queries AS SELECT id, vec::FLOAT[{dims}] AS vec FROM {reader}('{args.queries}') "
+        f"WHERE id < {args.num_queries}"
+    )
+    return dims
+
+
+def load_groundtruth(con, path, queries, k):
+    rows = con.execute(f"SELECT id, vec[1:{k}] FROM read_ivecs('{path}') WHERE id < {queries} ORDER BY id").fetchall()
+    return [list(ids) for _, ids in rows]
+
+
+def compute_groundtruth(con, dims, metric, k):
+    function, descending = METRIC_FUNCTIONS[metric]
+    aggregate = 'max_by' if descending else 'min_by'
+    rows = con.execute(
+        f"SELECT q.id, {aggregate}(v.id, {function}(v.vec, q.vec), {k}) "
+        f"FROM queries q, vectors v GROUP BY q.id ORDER BY q.id"
+    ).fetchall()
+    return [list(ids) for _, ids in rows]
+
+
+def search_query(dims, metric, vector, k):
+    # The query vector has to be a constant for the index scan to be used,
+    # so it is inlined rather than passed as a prepared statement parameter
+    function, _ = METRIC_FUNCTIONS[metric]
+    literal = '[' + ','.join(repr(float(x)) for x in vector) + ']'
+    return f"SELECT id FROM vectors ORDER BY {function}(vec, {literal}::FLOAT[{dims}]) LIMIT {k}"
+
+
+def run_benchmark(con, name, dims, args, writer):
+    k_values = args.k
+    max_k = max(k_values)
+    queries = con.execute("SELECT vec FROM queries ORDER BY id").fetchall()
+
+    if args.groundtruth:
+        groundtruth = load_groundtruth(con, args.groundtruth, len(queries), max_k)
+    else:
+        start = time.perf_counter()
+        groundtruth = compute_groundtruth(con, dims, args.metric, max_k)
+        print(f"[{name}] ground truth for {len(queries)} queries in {time.perf_counter() - start:.2f}s",
+              file=sys.stderr)
+
+    options = [f"metric = '{args.metric}'"]
+    if args.m:
+        options.append(f"m = {args.m}")
+    if args.ef_construction:
+        options.append(f"ef_construction = {args.ef_construction}")
+    start = time.perf_counter()
+    con.execute(f"CREATE INDEX vectors_idx ON vectors USING HNSW (vec) WITH ({', '.join(options)})")
+    build_time = time.perf_counter() - start
+    memory = con.execute(
+        "SELECT approx_memory_usage FROM pragma_hnsw_index_info() WHERE index_name = 'vectors_idx'"
+    ).fetchone()[0]
+    rows = con.execute("SELECT count(*) FROM vectors").fetchone()[0]
+
+    for ef in args.ef:
+        con.execute(f"SET hnsw_ef_search = {ef}")
+        for k in k_values:
+            statements = [search_query(dims, args.metric, vector, k) for (vector,) in queries]
+            hits = 0
+            start = time.perf_counter()
+            for i, statement in enumerate(statements):
+                result = con.execute(statement).fetchall()
+                hits += len(set(row[0] for row in result) & set(groundtruth[i][:k]))
+            elapsed = time.perf_counter() - start
+            record = {
+                'dataset': name,
+                'dims': dims,
+                'rows': rows,
+                'metric': args.metric,
+                'build_seconds': round(build_time, 3),
+                'index_bytes': memory,
+                'ef_search': ef,
+                'k': k,
+                'recall': round(hits / (k * len(statements)), 4),
+                'qps': round(len(statements) / elapsed, 1),
+            }
+            writer.writerow(record)
+            sys.stdout.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Recall and throughput benchmark for the HNSW index')
+    parser.add_argument('--extension', default=DEFAULT_EXTENSION, help='path to the vss extension binary')
+    parser.add_argument('--dims', type=parse_int_list, default=[128, 768, 1536],
+                        help='comma separated dimensions of the generated datasets')
+    parser.add_argument('--distribution', type=parse_str_list, default=['uniform', 'clustered'],
+                        help='comma separated distributions of the generated datasets (uniform, clustered)')
+    parser.add_argument('--rows', type=int,
+                        help='number of vectors to index, defaults to 100000 generated vectors or the whole --base file')
+    parser.add_argument('--num-queries', type=int, default=100, help='number of queries to run')
+    parser.add_argument('--base', help='fvecs or bvecs file to index instead of a generated dataset')
+    parser.add_argument('--queries', help='fvecs or bvecs file with the query vectors, required with --base')
+    parser.add_argument('--groundtruth', help='ivecs file with the exact neighbours of the queries')
+    parser.add_argument('--metric', default='l2sq', choices=sorted(METRIC_FUNCTIONS.keys()))
+    parser.add_argument('--m', type=int, help='the M parameter of the index')
+    parser.add_argument('--ef-construction', type=int, help='the ef_construction parameter of the index')
+    parser.add_argument('--ef', type=parse_int_list, default=[16, 32, 64, 128, 256],
+                        help='comma separated hnsw_ef_search values to measure')
+    parser.add_argument('--k', type=parse_int_list, default=[10, 100], help='comma separated recall@k values')
+    parser.add_argument('--threads', type=int, help='number of threads to use')
+    parser.add_argument('--seed', type=float, default=0.42, help='seed of the generated datasets')
+    parser.add_argument('--output', help='write the results to this CSV file instead of stdout')
+    args = parser.parse_args()
+
+    if args.base and not args.queries:
+        parser.error('--queries is required with --base')
+
+    output = open(args.output, 'w', newline='') if args.output else sys.stdout
+    writer = csv.DictWriter(output, fieldnames=['dataset', 'dims', 'rows', 'metric', 'build_seconds', 'index_bytes',
+                                                'ef_search', 'k', 'recall', 'qps'])
+    writer.writeheader()
+
+    if args.base:
+        con = connect(args)
+        dims = load_dataset(con, args)
+        run_benchmark(con, args.base, dims, args, writer)
+        con.close()
+    else:
+        for distribution in args.distribution:
+            for dims in args.dims:
+                con = connect(args)
+                generate_dataset(con, dims, args.rows or 100000, args.num_queries, distribution, args.seed)
+                run_benchmark(con, f"{distribution}-{dims}", dims, args, writer)
+                con.close()
+
+    if args.output:
+        output.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,310 @@
+// Micro-benchmarks for the distance kernels and the graph operations used by the HNSW index.
+//
+// The simsimd kernels are timed once for every ISA level that the CPU supports, and the usearch index is timed
+// adding and searching vectors across dimensions, scalar kinds and thread counts. The results are written to stdout
+// as CSV, one row per measurement.
+//
+// Usage: vss_micro_benchmark [--dims=128,768,1536] [--threads=1,4] [--rows=20000] [--queries=1000]
+//                            [--only=kernels|graph]
+
+#include "usearch/duckdb_usearch.hpp"
+
+#ifndef SIMSIMD_NATIVE_F16
+#define SIMSIMD_NATIVE_F16 0
+#endif
+#include "simsimd/simsimd.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// The minimum time to spend on a single kernel measurement
+constexpr double KERNEL_SECONDS = 0.2;
+// The number of vectors the kernels cycle through, so that not every call hits the same cache lines
+constexpr size_t KERNEL_VECTORS = 256;
+
+struct Options {
+	std::vector<size_t> dims = {128, 768, 1536};
+	std::vector<size_t> threads = {1, std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+	size_t rows = 20000;
+	size_t queries = 1000;
+	bool run_kernels = true;
+	bool run_graph = true;
+};
+
+struct IsaLevel {
+	simsimd_capability_t capability;
+	const char *name;
+};
+
+const IsaLevel ISA_LEVELS[] = {{simsimd_cap_serial_k, "serial"},     {simsimd_cap_neon_k, "neon"},
+                               {simsimd_cap_sve_k, "sve"},           {simsimd_cap_haswell_k, "haswell"},
+                               {simsimd_cap_skylake_k, "skylake"},   {simsimd_cap_ice_k, "ice"},
+                               {simsimd_cap_sapphire_k, "sapphire"}, {simsimd_cap_genoa_k, "genoa"}};
+
+struct KernelKind {
+	simsimd_metric_kind_t metric;
+	simsimd_datatype_t datatype;
+	const char *metric_name;
+	const char *scalar_name;
+	//! The size of a single scalar in bits
+	size_t bits;
+};
+
+const KernelKind KERNEL_KINDS[] = {
+    {simsimd_metric_l2sq_k, simsimd_datatype_f32_k, "l2sq", "f32", 32},
+    {simsimd_metric_cos_k, simsimd_datatype_f32_k, "cos", "f32", 32},
+    {simsimd_metric_dot_k, simsimd_datatype_f32_k, "ip", "f32", 32},
+    {simsimd_metric_l2sq_k, simsimd_datatype_f16_k, "l2sq", "f16", 16},
+    {simsimd_metric_cos_k, simsimd_datatype_f16_k, "cos", "f16", 16},
+    {simsimd_metric_dot_k, simsimd_datatype_f16_k, "ip", "f16", 16},
+    {simsimd_metric_l2sq_k, simsimd_datatype_i8_k, "l2sq", "i8", 8},
+    {simsimd_metric_cos_k, simsimd_datatype_i8_k, "cos", "i8", 8},
+    {simsimd_metric_hamming_k, simsimd_datatype_b8_k, "hamming", "b1", 1},
+    {simsimd_metric_jaccard_k, simsimd_datatype_b8_k, "jaccard", "b1", 1},
+};
+
+struct ScalarKind {
+	unum::usearch::scalar_kind_t kind;
+	const char *name;
+};
+
+const ScalarKind SCALAR_KINDS[] = {{unum::usearch::scalar_kind_t::f32_k, "f32"},
+                                   {unum::usearch::scalar_kind_t::f16_k, "f16"},
+                                   {unum::usearch::scalar_kind_t::i8_k, "i8"}};
+
+std::vector<size_t> ParseList(const char *value) {
+	std::vector<size_t> result;
+	std::string list(value);
+	size_t start = 0;
+	while (start < list.size()) {
+		auto end = list.find(',', start);
+		if (end == std::string::npos) {
+			end = list.size();
+		}
+		if (end > start) {
+			result.push_back(std::stoul(list.substr(start, end - start)));
+		}
+		start = end + 1;
+	}
+	return result;
+}
+
+bool ParseOptions(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; i++) {
+		std::string arg(argv[i]);
+		auto split = arg.find('=');
+		auto name = arg.substr(0, split);
+		auto value = split == std::string::npos ? std::string() : arg.substr(split + 1);
+		if (name == "--dims") {
+			options.dims = ParseList(value.c_str());
+		} else if (name == "--threads") {
+			options.threads = ParseList(value.c_str());
+		} else if (name == "--rows") {
+			options.rows = std::stoul(value);
+		} else if (name == "--queries") {
+			options.queries = std::stoul(value);
+		} else if (name == "--only" && (value == "kernels" || value == "graph")) {
+			options.run_kernels = value == "kernels";
+			options.run_graph = value == "graph";
+		} else {
+			fprintf(stderr,
+			        "Usage: %s [--dims=128,768,1536] [--threads=1,4] [--rows=20000] [--queries=1000] "
+			        "[--only=kernels|graph]\n",
+			        argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+void PrintRow(const char *benchmark, const char *isa, const char *metric, const char *scalar, size_t dims,
+              size_t threads, size_t count, double seconds) {
+	printf("%s,%s,%s,%s,%zu,%zu,%zu,%.6f,%.1f\n", benchmark, isa, metric, scalar, dims, threads, count, seconds,
+	       static_cast<double>(count) / seconds);
+	fflush(stdout);
+}
+
+double SecondsSince(Clock::time_point start) {
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//-------------------------------------------------------------------------
+// Kernels
+//-------------------------------------------------------------------------
+
+// Fill the buffer with random vectors of the given datatype
+void FillVectors(simsimd_datatype_t datatype, std::vector<uint8_t> &buffer, std::mt19937 &rng) {
+	std::uniform_real_distribution<float> real(-1, 1);
+	std::uniform_int_distribution<int> byte(0, 255);
+	switch (datatype) {
+	case simsimd_datatype_f32_k: {
+		auto data = reinterpret_cast<simsimd_f32_t *>(buffer.data());
+		for (size_t i = 0; i < buffer.size() / sizeof(simsimd_f32_t); i++) {
+			data[i] = real(rng);
+		}
+		break;
+	}
+	case simsimd_datatype_f16_k: {
+		auto data = reinterpret_cast<unsigned short *>(buffer.data());
+		for (size_t i = 0; i < buffer.size() / sizeof(unsigned short); i++) {
+			data[i] = simsimd_compress_f16(real(rng));
+		}
+		break;
+	}
+	case simsimd_datatype_i8_k: {
+		std::uniform_int_distribution<int> small(-100, 100);
+		for (auto &value : buffer) {
+			value = static_cast<uint8_t>(static_cast<int8_t>(small(rng)));
+		}
+		break;
+	}
+	default:
+		for (auto &value : buffer) {
+			value = static_cast<uint8_t>(byte(rng));
+		}
+		break;
+	}
+}
+
+void RunKernelBenchmarks(const Options &options) {
+	const auto supported = simsimd_capabilities();
+	std::mt19937 rng(42);
+
+	for (auto &kind : KERNEL_KINDS) {
+		for (auto dims : options.dims) {
+			// Binary vectors are passed as the number of 8-bit words
+			const auto words = kind.bits == 1 ? (dims + 7) / 8 : dims;
+			const auto vector_bytes = kind.bits == 1 ? words : dims * kind.bits / 8;
+			std::vector<uint8_t> vectors(vector_bytes * KERNEL_VECTORS);
+			FillVectors(kind.datatype, vectors, rng);
+
+			for (auto &isa : ISA_LEVELS) {
+				if (!(supported & isa.capability)) {
+					continue;
+				}
+				simsimd_metric_punned_t kernel = nullptr;
+				simsimd_capability_t used = simsimd_cap_serial_k;
+				simsimd_find_metric_punned(kind.metric, kind.datatype, supported, isa.capability, &kernel, &used);
+				if (!kernel || used != isa.capability) {
+					// There is no kernel for this ISA level, it would fall back to another one
+					continue;
+				}
+
+				// Call the kernel in rounds over all pairs of neighbouring vectors until enough time has passed
+				size_t calls = 0;
+				simsimd_distance_t sink = 0;
+				auto start = Clock::now();
+				double elapsed = 0;
+				while (elapsed < KERNEL_SECONDS) {
+					for (size_t i = 0; i + 1 < KERNEL_VECTORS; i++) {
+						simsimd_distance_t distance;
+						kernel(vectors.data() + i * vector_bytes, vectors.data() + (i + 1) * vector_bytes, words,
+						       &distance);
+						sink += distance;
+					}
+					calls += KERNEL_VECTORS - 1;
+					elapsed = SecondsSince(start);
+				}
+				if (sink == 42.4242) {
+					// Keep the compiler from dropping the calls
+					fprintf(stderr, "%f\n", sink);
+				}
+				PrintRow("kernel", isa.name, kind.metric_name, kind.scalar_name, dims, 1, calls, elapsed);
+			}
+		}
+	}
+}
+
+//-------------------------------------------------------------------------
+// Graph
+//-------------------------------------------------------------------------
+
+// Run the function for every item on the given number of threads, each thread handling every n-th item
+template <class FUNC>
+double RunParallel(size_t threads, size_t count, FUNC &&func) {
+	auto start = Clock::now();
+	std::vector<std::thread> workers;
+	for (size_t thread = 0; thread < threads; thread++) {
+		workers.emplace_back([&, thread]() {
+			for (size_t i = thread; i < count; i += threads) {
+				func(thread, i);
+			}
+		});
+	}
+	for (auto &worker : workers) {
+		worker.join();
+	}
+	return SecondsSince(start);
+}
+
+void RunGraphBenchmarks(const Options &options) {
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> real(-1, 1);
+
+	for (auto dims : options.dims) {
+		std::vector<float> rows(options.rows * dims);
+		for (auto &value : rows) {
+			value = real(rng);
+		}
+		std::vector<float> queries(options.queries * dims);
+		for (auto &value : queries) {
+			value = real(rng);
+		}
+
+		for (auto &scalar : SCALAR_KINDS) {
+			for (auto threads : options.threads) {
+				unum::usearch::metric_punned_t metric(dims, unum::usearch::metric_kind_t::l2sq_k, scalar.kind);
+				unum::usearch::index_dense_config_t config = {};
+				auto index = unum::usearch::index_dense_gt<int64_t>::make(metric, config);
+				index.reserve(unum::usearch::index_limits_t(options.rows, threads));
+
+				auto add_seconds = RunParallel(threads, options.rows, [&](size_t thread, size_t i) {
+					auto result = index.add(static_cast<int64_t>(i), rows.data() + i * dims, thread);
+					if (!result) {
+						fprintf(stderr, "Failed to add vector %zu: %s\n", i, result.error.release());
+						exit(1);
+					}
+				});
+				PrintRow("add", metric.isa_name(), "l2sq", scalar.name, dims, threads, options.rows, add_seconds);
+
+				auto search_seconds = RunParallel(threads, options.queries, [&](size_t thread, size_t i) {
+					auto result = index.search(queries.data() + i * dims, 10, thread);
+					if (!result) {
+						fprintf(stderr, "Failed to search vector %zu: %s\n", i, result.error.release());
+						exit(1);
+					}
+				});
+				PrintRow("search", metric.isa_name(), "l2sq", scalar.name, dims, threads, options.queries,
+				         search_seconds);
+			}
+		}
+	}
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		return 1;
+	}
+
+	printf("benchmark,isa,metric,scalar,dims,threads,count,seconds,per_second\n");
+	if (options.run_kernels) {
+		RunKernelBenchmarks(options);
+	}
+	if (options.run_graph) {
+		RunGraphBenchmarks(options);
+	}
+	return 0;
+}
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+Mixed-workload stress benchmark for the HNSW index of the vss extension.
+
+Reader threads issue index scans while writer threads insert and delete rows, and the index is compacted and the
+database checkpointed on a timer. Reports the search latency percentiles, the ingest throughput, and the time
+spent waiting for the index lock, as counted by pragma_hnsw_index_info().
+
+Example:
+    python3 benchmark/stress_benchmark.py --readers 8 --writers 2 --duration 60
+"""
+
+import argparse
+import os
+import random
+import sys
+import tempfile
+import threading
+import time
+
+import duckdb
+
+DEFAULT_EXTENSION = 'build/release/extension/vss/vss.duckdb_extension'
+
+LOCK_COLUMNS = ['shared_lock_acquisitions', 'shared_lock_wait_us', 'exclusive_lock_acquisitions',
+                'exclusive_lock_wait_us']
+
+
+def random_vector(rng, dims):
+    return [rng.random() for _ in range(dims)]
+
+
+def vector_literal(vector, dims):
+    return '[' + ','.join(repr(x) for x in vector) + f']::FLOAT[{dims}]'
+
+
+def percentile(values, fraction):
+    if not values:
+        return float('nan')
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+def lock_stats(con):
+    row = con.execute(
+        f"SELECT {', '.join(LOCK_COLUMNS)} FROM pragma_hnsw_index_info() WHERE index_name = 'stress_idx'"
+    ).fetchone()
+    return dict(zip(LOCK_COLUMNS, row))
+
+
+class Worker(threading.Thread):
+    """Runs an operation in a loop on its own connection until the benchmark is stopped"""
+
+    def __init__(self, db, stop, seed, interval=0.0):
+        super().__init__(daemon=True)
+        self.con = db.cursor()
+        self.stop = stop
+        self.rng = random.Random(seed)
+        self.interval = interval
+        self.latencies = []
+        self.rows = 0
+        self.errors = 0
+
+    def step(self):
+        raise NotImplementedError
+
+    def run(self):
+        while not self.stop.is_set():
+            start = time.perf_counter()
+            try:
+                self.step()
+            except duckdb.Error as e:
+                # Write-write conflicts between the writers are expected, anything else is not
+                if 'Conflict' not in str(e):
+                    print(f"{type(self).__name__}: {e}", file=sys.stderr)
+                self.errors += 1
+                continue
+            self.latencies.append(time.perf_counter() - start)
+            if self.interval:
+                self.stop.wait(self.interval)
+
+
+class Reader(Worker):
+    def __init__(self, db, stop, seed, args):
+        super().__init__(db, stop, seed)
+        self.args = args
+
+    def step(self):
+        query = vector_literal(random_vector(self.rng, self.args.dims), self.args.dims)
+        self.con.execute(f"SELECT id FROM vectors ORDER BY array_distance(vec, {query}) LIMIT {self.args.k}")
+        self.con.fetchall()
+
+
+class Writer(Worker):
+    def __init__(self, db, stop, seed, args, next_id):
+        super().__init__(db, stop, seed)
+        self.args = args
+        self.next_id = next_id
+
+    def step(self):
+        # Insert a batch of new rows, then delete a fraction of that many random existing rows
+        with self.next_id['lock']:
+            first = self.next_id['value']
+            self.next_id['value'] += self.args.batch
+        values = ', '.join(
+            f"({first + i}, {vector_literal(random_vector(self.rng, self.args.dims), self.args.dims)})"
+            for i in range(self.args.batch)
+        )
+        self.con.execute(f"INSERT INTO vectors VALUES {values}")
+        self.rows += self.args.batch
+
+        deletes = int(self.args.batch * self.args.delete_ratio)
+        if deletes:
+            ids = ', '.join(str(self.rng.randrange(first)) for _ in range(deletes))
+            self.con.execute(f"DELETE FROM vectors WHERE id IN ({ids})")
+
+
+class Statement(Worker):
+    """Runs a fixed statement on a timer, e.g. a compaction or a checkpoint"""
+
+    def __init__(self, db, stop, name, interval, statement):
+        super().__init__(db, stop, 0, interval)
+        self.name = name
+        self.statement = statement
+
+    def step(self):
+        self.con.execute(self.statement)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Mixed read/write stress benchmark for the HNSW index')
+    parser.add_argument('--extension', default=DEFAULT_EXTENSION, help='path to the vss extension binary')
+    parser.add_argument('--database', help='database file to use, a temporary file by default')
+    parser.add_argument('--dims', type=int, default=128, help='number of dimensions of the vectors')
+    parser.add_argument('--rows', type=int, default=100000, help='number of rows to index before starting')
+    parser.add_argument('--readers', type=int, default=4, help='number of reader connections')
+    parser.add_argument('--writers', type=int, default=1, help='number of writer connections')
+    parser.add_argument('--batch', type=int, default=100, help='number of rows inserted per write')
+    parser.add_argument('--delete-ratio', type=float, default=0.1, help='rows deleted per inserted row')
+    parser.add_argument('--k', type=int, default=10, help='number of rows returned by every search')
+    parser.add_argument('--compact-interval', type=float, default=10, help='seconds between compactions, 0 for none')
+    parser.add_argument('--checkpoint-interval', type=float, default=5,
+                        help='seconds between checkpoints, 0 for none')
+    parser.add_argument('--duration', type=float, default=30, help='seconds to run the workload for')
+    parser.add_argument('--threads', type=int, help='number of DuckDB threads')
+    args = parser.parse_args()
+
+    directory = None
+    path = args.database
+    if not path:
+        directory = tempfile.TemporaryDirectory()
+        path = os.path.join(directory.name, 'stress.db')
+
+    db = duckdb.connect(path, config={'allow_unsigned_extensions': 'true'})
+    db.execute(f"LOAD '{args.extension}'")
+    db.execute("SET hnsw_enable_experimental_persistence = true")
+    if args.threads:
+        db.execute(f"SET threads = {args.threads}")
+
+    print(f"Loading {args.rows} rows of {args.dims} dimensions", file=sys.stderr)
+    db.execute("SELECT setseed(0.42)")
+    db.execute(
+        f"CREATE OR REPLACE TABLE vectors AS SELECT i AS id, "
+        f"list_transform(range({args.dims}), x -> random()::FLOAT)::FLOAT[{args.dims}] AS vec "
+        f"FROM range({args.rows}) r(i)"
+    )
+    start = time.perf_counter()
+    db.execute("CREATE INDEX stress_idx ON vectors USING HNSW (vec)")
+    db.execute("CHECKPOINT")
+    print(f"Built the index in {time.perf_counter() - start:.2f}s", file=sys.stderr)
+
+    stop = threading.Event()
+    next_id = {'value': args.rows, 'lock': threading.Lock()}
+    readers = [Reader(db, stop, i, args) for i in range(args.readers)]
+    writers = [Writer(db, stop, 1000 + i, args, next_id) for i in range(args.writers)]
+    maintenance = []
+    if args.compact_interval:
+        maintenance.append(
+            Statement(db, stop, 'compaction', args.compact_interval, "PRAGMA hnsw_compact_index('stress_idx')")
+        )
+    if args.checkpoint_interval:
+        maintenance.append(Statement(db, stop, 'checkpoint', args.checkpoint_interval, "CHECKPOINT"))
+
+    before = lock_stats(db)
+    workers = readers + writers + maintenance
+    start = time.perf_counter()
+    for worker in workers:
+        worker.start()
+    stop.wait(args.duration)
+    stop.set()
+    for worker in workers:
+        worker.join()
+    elapsed = time.perf_counter() - start
+    after = lock_stats(db)
+
+    searches = [latency for reader in readers for latency in reader.latencies]
+    inserted = sum(writer.rows for writer in writers)
+    print(f"duration_s,{elapsed:.2f}")
+    print(f"searches,{len(searches)}")
+    print(f"search_qps,{len(searches) / elapsed:.1f}")
+    print(f"search_p50_ms,{percentile(searches, 0.50) * 1000:.3f}")
+    print(f"search_p99_ms,{percentile(searches, 0.99) * 1000:.3f}")
+    print(f"search_max_ms,{max(searches, default=float('nan')) * 1000:.3f}")
+    print(f"ingest_rows_per_s,{inserted / elapsed:.1f}")
+    print(f"write_conflicts,{sum(writer.errors for writer in writers)}")
+    for worker in maintenance:
+        print(f"{worker.name}s,{len(worker.latencies)}")
+        print(f"{worker.name}_max_ms,{max(worker.latencies, default=float('nan')) * 1000:.3f}")
+    for column in LOCK_COLUMNS:
+        print(f"{column},{after[column] - before[column]}")
+
+    db.close()
+    if directory:
+        directory.cleanup()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,94 @@
+#include "common/linked_block.hpp"
+
+#include "duckdb/common/types/hash.hpp"
+
+namespace duckdb {
+
+constexpr idx_t LinkedBlock::BLOCK_DATA_SIZE;
+constexpr idx_t LinkedBlock::BLOCK_SIZE;
+
+//------------------------------------------------------------------------------
+// Reader
+//------------------------------------------------------------------------------
+
+void LinkedBlockReader::Reset() {
+	current_pointer = root_pointer;
+	position_in_block = 0;
+}
+
+idx_t LinkedBlockReader::ReadData(data_ptr_t buffer, idx_t length) {
+	idx_t bytes_read = 0;
+	while (bytes_read < length) {
+
+		// TODO: Check if current pointer is valid
+
+		auto block = allocator.Get<const LinkedBlock>(current_pointer, false);
+		auto block_data = block->data;
+		auto data_to_read = std::min(length - bytes_read, LinkedBlock::BLOCK_DATA_SIZE - position_in_block);
+		std::memcpy(buffer + bytes_read, block_data + position_in_block, data_to_read);
+
+		bytes_read += data_to_read;
+		position_in_block += data_to_read;
+
+		if (position_in_block == LinkedBlock::BLOCK_DATA_SIZE) {
+			position_in_block = 0;
+			current_pointer = block->next_block;
+		}
+	}
+
+	return bytes_read;
+}
+
+hash_t LinkedBlockReader::HashBlocks() {
+	hash_t hash = 0;
+	auto pointer = root_pointer;
+	while (true) {
+		auto block = allocator.Get<const LinkedBlock>(pointer, false);
+		hash = CombineHash(hash, Hash(block->data, LinkedBlock::BLOCK_DATA_SIZE));
+
+		// The last block of the chain has no next block
+		if (block->next_block.Get() == 0) {
+			break;
+		}
+		pointer = block->next_block;
+	}
+	return hash;
+}
+
+//------------------------------------------------------------------------------
+// Writer
+//------------------------------------------------------------------------------
+
+void LinkedBlockWriter::ClearCurrentBlock() {
+	auto block = allocator.Get<LinkedBlock>(current_pointer, true);
+	block->next_block.Clear();
+	memset(block->data, 0, LinkedBlock::BLOCK_DATA_SIZE);
+}
+
+void LinkedBlockWriter::Reset() {
+	current_pointer = root_pointer;
+	position_in_block = 0;
+	ClearCurrentBlock();
+}
+
+void LinkedBlockWriter::WriteData(const_data_ptr_t buffer, idx_t length) {
+	idx_t bytes_written = 0;
+	while (bytes_written < length) {
+		auto block = allocator.Get<LinkedBlock>(current_pointer, true);
+		auto block_data = block->data;
+		auto data_to_write = std::min(length - bytes_written, LinkedBlock::BLOCK_DATA_SIZE - position_in_block);
+		std::memcpy(block_data + position_in_block, buffer + bytes_written, data_to_write);
+
+		bytes_written += data_to_write;
+		position_in_block += data_to_write;
+
+		if (position_in_block == LinkedBlock::BLOCK_DATA_SIZE) {
+			position_in_block = 0;
+			block->next_block = allocator.New();
+			current_pointer = block->next_block;
+			ClearCurrentBlock();
+		}
+	}
+}
+
+} // namespace duckdb
@@ -0,0 +1,145 @@
+#include "hnsw/hnsw_build_order.hpp"
+
+#include "duckdb/common/random_engine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace duckdb {
+
+const case_insensitive_set_t HNSWBuildOrder::KINDS = {SCAN, SHUFFLE, CLUSTER};
+
+// Draw a random number in [0, bound)
+static idx_t NextIndex(RandomEngine &engine, idx_t bound) {
+	return MinValue(static_cast<idx_t>(engine.NextRandom() * static_cast<double>(bound)), bound - 1);
+}
+
+static void ShuffleInPlace(vector<idx_t> &order, RandomEngine &engine) {
+	// Fisher-Yates
+	for (idx_t i = order.size(); i > 1; i--) {
+		std::swap(order[i - 1], order[NextIndex(engine, i)]);
+	}
+}
+
+vector<idx_t> HNSWBuildOrder::Shuffle(idx_t count, RandomEngine &engine) {
+	vector<idx_t> order(count);
+	for (idx_t i = 0; i < count; i++) {
+		order[i] = i;
+	}
+	ShuffleInPlace(order, engine);
+	return order;
+}
+
+static float SquaredDistance(const float *lhs, const float *rhs, idx_t dims) {
+	float result = 0;
+	for (idx_t i = 0; i < dims; i++) {
+		const auto diff = lhs[i] - rhs[i];
+		result += diff * diff;
+	}
+	return result;
+}
+
+static idx_t NearestCentroid(const float *vec, const vector<float> &centroids, idx_t clusters, idx_t dims) {
+	idx_t nearest = 0;
+	auto nearest_distance = std::numeric_limits<float>::max();
+	for (idx_t c = 0; c < clusters; c++) {
+		const auto distance = SquaredDistance(vec, centroids.data() + c * dims, dims);
+		if (distance < nearest_distance) {
+			nearest_distance = distance;
+			nearest = c;
+		}
+	}
+	return nearest;
+}
+
+vector<idx_t> HNSWBuildOrder::ClusterInterleave(const float *vectors, idx_t count, idx_t dims, RandomEngine &engine) {
+	const auto clusters = MaxValue<idx_t>(1, MinValue(MAX_CLUSTERS, count / VECTORS_PER_CLUSTER));
+	if (clusters == 1) {
+		return Shuffle(count, engine);
+	}
+
+	// Train the centroids on a random sample, starting from random members of the sample
+	auto sample = Shuffle(count, engine);
+	sample.resize(MinValue(count, clusters * SAMPLE_PER_CLUSTER));
+
+	vector<float> centroids(clusters * dims);
+	for (idx_t c = 0; c < clusters; c++) {
+		std::copy(vectors + sample[c] * dims, vectors + (sample[c] + 1) * dims, centroids.begin() + c * dims);
+	}
+
+	vector<float> sums(clusters * dims);
+	vector<idx_t> sizes(clusters);
+	for (idx_t iteration = 0; iteration < KMEANS_ITERATIONS; iteration++) {
+		std::fill(sums.begin(), sums.end(), 0.0f);
+		std::fill(sizes.begin(), sizes.end(), 0);
+		for (auto idx : sample) {
+			const auto vec = vectors + idx * dims;
+			const auto c = NearestCentroid(vec, centroids, clusters, dims);
+			for (idx_t d = 0; d < dims; d++) {
+				sums[c * dims + d] += vec[d];
+			}
+			sizes[c]++;
+		}
+		for (idx_t c = 0; c < clusters; c++) {
+			if (sizes[c] == 0) {
+				// Keep the centroids of empty clusters where they are
+				continue;
+			}
+			for (idx_t d = 0; d < dims; d++) {
+				centroids[c * dims + d] = sums[c * dims + d] / static_cast<float>(sizes[c]);
+			}
+		}
+	}
+
+	// Assign every vector to its nearest centroid
+	vector<vector<idx_t>> members(clusters);
+	for (idx_t i = 0; i < count; i++) {
+		members[NearestCentroid(vectors + i * dims, centroids, clusters, dims)].push_back(i);
+	}
+
+	// Interleave the shuffled clusters, so that every cluster is visited at the same rate: the i-th of the n members
+	// of a cluster is inserted at the fraction (i + 0.5) / n of the build
+	vector<std::pair<double, idx_t>> keys;
+	keys.reserve(count);
+	for (auto &cluster : members) {
+		ShuffleInPlace(cluster, engine);
+		for (idx_t i = 0; i < cluster.size(); i++) {
+			keys.emplace_back((static_cast<double>(i) + 0.5) / static_cast<double>(cluster.size()), cluster[i]);
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+
+	vector<idx_t> order;
+	order.reserve(count);
+	for (auto &key : keys) {
+		order.push_back(key.second);
+	}
+	return order;
+}
+
+idx_t HNSWBuildOrder::PartitionUpperLevels(vector<idx_t> &order, vector<int32_t> &levels, double connectivity,
+                                           RandomEngine &engine) {
+	// Same distribution as usearch: floor(-ln(u) / ln(M)) for a uniform u in (0, 1]
+	const auto inverse_log_connectivity = 1.0 / std::log(connectivity);
+
+	vector<idx_t> base;
+	base.reserve(order.size());
+	levels.clear();
+
+	idx_t upper_count = 0;
+	for (auto idx : order) {
+		const auto uniform = MaxValue(1.0 - engine.NextRandom(), std::numeric_limits<double>::min());
+		const auto level = static_cast<int32_t>(-std::log(uniform) * inverse_log_connectivity);
+		if (level > 0) {
+			order[upper_count++] = idx;
+			levels.push_back(level);
+		} else {
+			base.push_back(idx);
+		}
+	}
+	std::copy(base.begin(), base.end(), order.begin() + static_cast<int64_t>(upper_count));
+	return upper_count;
+}
+
+} // namespace duckdb
@@ -1,118 +1,30 @@
 #include "hnsw/hnsw_index.hpp"
 
+#include "duckdb/common/algorithm.hpp"
+#include "duckdb/common/chrono.hpp"
 #include "duckdb/common/serializer/binary_deserializer.hpp"
 #include "duckdb/common/serializer/binary_serializer.hpp"
 #include "duckdb/execution/index/fixed_size_allocator.hpp"
+#include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/catalog/catalog_entry/index_catalog_entry.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/table/scan_state.hpp"
+#include "duckdb/transaction/duck_transaction.hpp"
+#include "duckdb/transaction/duck_transaction_manager.hpp"
 #include "hnsw/hnsw.hpp"
+#include "hnsw/hnsw_build_order.hpp"
+#include "hnsw/hnsw_simd.hpp"
+#include "common/linked_block.hpp"
 
 namespace duckdb {
 
-//------------------------------------------------------------------------------
-// Linked Blocks
-//------------------------------------------------------------------------------
-
-class LinkedBlock {
-public:
-	static constexpr const idx_t BLOCK_SIZE = Storage::BLOCK_SIZE - sizeof(validity_t);
-	static constexpr const idx_t BLOCK_DATA_SIZE = BLOCK_SIZE - sizeof(IndexPointer);
-	static_assert(BLOCK_SIZE > sizeof(IndexPointer), "Block size must be larger than the size of an IndexPointer");
-
-	IndexPointer next_block;
-	char data[BLOCK_DATA_SIZE] = {0};
-};
-
-constexpr idx_t LinkedBlock::BLOCK_DATA_SIZE;
-constexpr idx_t LinkedBlock::BLOCK_SIZE;
-
-class LinkedBlockReader {
-private:
-	FixedSizeAllocator &allocator;
-
-	IndexPointer root_pointer;
-	IndexPointer current_pointer;
-	idx_t position_in_block;
-
-public:
-	LinkedBlockReader(FixedSizeAllocator &allocator, IndexPointer root_pointer)
-	    : allocator(allocator), root_pointer(root_pointer), current_pointer(root_pointer), position_in_block(0) {
-	}
-
-	void Reset() {
-		current_pointer = root_pointer;
-		position_in_block = 0;
-	}
-
-	idx_t ReadData(data_ptr_t buffer, idx_t length) {
-		idx_t bytes_read = 0;
-		while (bytes_read < length) {
-
-			// TODO: Check if current pointer is valid
-
-			auto block = allocator.Get<const LinkedBlock>(current_pointer, false);
-			auto block_data = block->data;
-			auto data_to_read = std::min(length - bytes_read, LinkedBlock::BLOCK_DATA_SIZE - position_in_block);
-			std::memcpy(buffer + bytes_read, block_data + position_in_block, data_to_read);
-
-			bytes_read += data_to_read;
-			position_in_block += data_to_read;
-
-			if (position_in_block == LinkedBlock::BLOCK_DATA_SIZE) {
-				position_in_block = 0;
-				current_pointer = block->next_block;
-			}
-		}
-
-		return bytes_read;
-	}
-};
-
-class LinkedBlockWriter {
-private:
-	FixedSizeAllocator &allocator;
-
-	IndexPointer root_pointer;
-	IndexPointer current_pointer;
-	idx_t position_in_block;
-
-public:
-	LinkedBlockWriter(FixedSizeAllocator &allocator, IndexPointer root_pointer)
-	    : allocator(allocator), root_pointer(root_pointer), current_pointer(root_pointer), position_in_block(0) {
-	}
-
-	void ClearCurrentBlock() {
-		auto block = allocator.Get<LinkedBlock>(current_pointer, true);
-		block->next_block.Clear();
-		memset(block->data, 0, LinkedBlock::BLOCK_DATA_SIZE);
-	}
-
-	void Reset() {
-		current_pointer = root_pointer;
-		position_in_block = 0;
-		ClearCurrentBlock();
-	}
-
-	void WriteData(const_data_ptr_t buffer, idx_t length) {
-		idx_t bytes_written = 0;
-		while (bytes_written < length) {
-			auto block = allocator.Get<LinkedBlock>(current_pointer, true);
-			auto block_data = block->data;
-			auto data_to_write = std::min(length - bytes_written, LinkedBlock::BLOCK_DATA_SIZE - position_in_block);
-			std::memcpy(block_data + position_in_block, buffer + bytes_written, data_to_write);
-
-			bytes_written += data_to_write;
-			position_in_block += data_to_write;
-
-			if (position_in_block == LinkedBlock::BLOCK_DATA_SIZE) {
-				position_in_block = 0;
-				block->next_block = allocator.New();
-				current_pointer = block->next_block;
-				ClearCurrentBlock();
-			}
-		}
-	}
-};
-
 //------------------------------------------------------------------------------
 // HNSWIndex Methods
 //------------------------------------------------------------------------------
@@ -138,7 +50,7 @@ HNSWIndex::HNSWIndex(const string &name, IndexConstraintType index_constraint_ty
 	D_ASSERT(vector_type.id() == LogicalTypeId::ARRAY);
 
 	// Get the size of the vector
-	auto vector_size = ArrayType::GetSize(vector_type);
+	vector_size = ArrayType::GetSize(vector_type);
 	auto vector_child_type = ArrayType::GetChildType(vector_type);
 
 	// Get the scalar kind from the array child type. This parameter should be verified during binding.
@@ -158,8 +70,31 @@ HNSWIndex::HNSWIndex(const string &name, IndexConstraintType index_constraint_ty
 		}
 	}
 
+	// Build the graph on a prefix of the dimensions only, if requested. This parameter should be verified during binding.
+	auto search_dims = vector_size;
+	auto search_dims_opt = options.find("search_dims");
+	if (search_dims_opt != options.end()) {
+		search_dims = search_dims_opt->second.GetValue<int32_t>();
+	}
+	requires_refinement = search_dims != vector_size;
+
+	// Or project the vectors into a lower-dimensional space. These parameters should be verified during binding.
+	auto projection_opt = options.find("projection");
+	if (projection_opt != options.end()) {
+		auto projection_dims_opt = options.find("projection_dims");
+		D_ASSERT(projection_dims_opt != options.end());
+		search_dims = projection_dims_opt->second.GetValue<int32_t>();
+		projection = make_uniq<HNSWProjection>(vector_size, search_dims);
+		learn_projection = StringUtil::CIEquals(projection_opt->second.GetValue<string>(), "pca");
+
+		// Re-rank using the original vectors unless explicitly disabled
+		auto rerank_opt = options.find("rerank");
+		requires_refinement = rerank_opt == options.end() || rerank_opt->second.GetValue<bool>();
+	}
+
 	// Create the usearch index
-	unum::usearch::metric_punned_t metric(vector_size, metric_kind, scalar_kind);
+	unum::usearch::metric_punned_t metric(search_dims, metric_kind, scalar_kind);
+	refine_metric = unum::usearch::metric_punned_t(vector_size, metric_kind, unum::usearch::scalar_kind_t::f32_k);
 	unum::usearch::index_dense_config_t config = {};
 
 	// We dont need to do key lookups (id -> vector) in the index, DuckDB stores the vectors separately
@@ -186,9 +121,25 @@ HNSWIndex::HNSWIndex(const string &name, IndexConstraintType index_constraint_ty
 		config.connectivity_base = m0_opt->second.GetValue<int32_t>();
 	}
 
-	index = unum::usearch::index_dense_gt<row_t>::make(metric, config);
+	// Back the arenas of the nodes and vectors with huge pages. This parameter should be verified during binding.
+	auto huge_pages_opt = options.find("huge_pages");
+	if (huge_pages_opt != options.end()) {
+		config.huge_pages = HUGE_PAGES_MAP.at(huge_pages_opt->second.GetValue<string>());
+	}
+
+	// Use wide slots if the index was created with them, the slot width is picked from the row count at creation
+	auto slot_bytes_opt = options.find("slot_bytes");
+	auto wide_slots = slot_bytes_opt != options.end() &&
+	                  slot_bytes_opt->second.GetValue<int32_t>() == static_cast<int32_t>(HNSWGraph::WIDE_SLOT_BYTES);
 
-	auto lock = rwlock.GetExclusiveLock();
+	index.initialize(metric, config, wide_slots);
+
+	auto compress_opt = options.find("compress_neighbors");
+	compress_neighbors = compress_opt != options.end() && compress_opt->second.GetValue<bool>();
+
+	simd_capabilities = HNSWSimd::ALL_CAPABILITIES;
+
+	auto lock = GetExclusiveLock();
 	// Is this a new index or an existing index?
 	if (info.IsValid()) {
 		// This is an old index that needs to be loaded
@@ -200,20 +151,306 @@ HNSWIndex::HNSWIndex(const string &name, IndexConstraintType index_constraint_ty
 
 		// Is there anything to deserialize? We could have an empty index
 		if (!info.allocator_infos[0].buffer_ids.empty()) {
-			LinkedBlockReader reader(*linked_block_allocator, root_block_ptr);
-			index.load_from_stream(
-			    [&](void *data, size_t size) { return size == reader.ReadData(static_cast<data_ptr_t>(data), size); });
+			// Indexes of read-only databases can't change, so their graph can be shared between processes
+			Value mmap_directory;
+			if (db.IsReadOnly() && db.GetDatabase().TryGetCurrentSetting(MMAP_DIRECTORY_SETTING, mmap_directory) &&
+			    !mmap_directory.IsNull() && !mmap_directory.ToString().empty()) {
+				MapFromDirectory(db, mmap_directory.ToString());
+			} else {
+				LinkedBlockReader reader(*linked_block_allocator, root_block_ptr);
+				Deserialize(reader);
+			}
 		}
 	} else {
 		index.reserve(MinValue(static_cast<idx_t>(32), estimated_cardinality));
+
+		// Start out with a random projection, a PCA projection is learned once data is available
+		if (projection) {
+			RandomEngine engine;
+			projection->InitializeRandom(engine);
+		}
 	}
 	index_size = index.size();
+
+	// Loading the index picks the best kernels again, so pin them after it
+	auto capabilities = HNSWSimd::GetConfiguredCapabilities(db.GetDatabase());
+	if (capabilities != simd_capabilities) {
+		ConfigureMetric(capabilities);
+	}
+
+	// Warm up a loaded index right away if requested, rather than on the first queries against it. This only reads
+	// the graph, so the exclusive lock is not needed for it.
+	lock.reset();
+	Value warmup_on_load;
+	if (info.IsValid() && db.GetDatabase().TryGetCurrentSetting(WARMUP_ON_LOAD_SETTING, warmup_on_load) &&
+	    !warmup_on_load.IsNull() && warmup_on_load.GetValue<bool>()) {
+		Warmup(DEFAULT_WARMUP_QUERIES);
+	}
+}
+
+void HNSWIndex::Deserialize(LinkedBlockReader &reader) {
+	index.load_from_stream(
+	    [&](void *data, size_t size) { return size == reader.ReadData(static_cast<data_ptr_t>(data), size); });
+
+	// The projection is stored right after the graph
+	if (projection) {
+		reader.ReadData(reinterpret_cast<data_ptr_t>(projection->matrix.data()), projection->GetSizeInBytes());
+	}
+}
+
+void HNSWIndex::MapFromDirectory(AttachedDatabase &db, const string &directory) {
+	auto &fs = FileSystem::GetFileSystem(db.GetDatabase());
+
+	// Name the copy after the contents of the index, so that every process attaching this version of the database
+	// maps the same file, and a new version of the index gets a new copy
+	LinkedBlockReader reader(*linked_block_allocator, root_block_ptr);
+	mapped_path = fs.JoinPath(directory, StringUtil::Format("hnsw-%016llx.usearch", reader.HashBlocks()));
+
+	if (!fs.FileExists(mapped_path)) {
+		// Load the index once, and write it out in the raw format usearch can map. Processes racing to create the
+		// copy each write their own temporary file and rename it, so the copy is never seen half-written
+		reader.Reset();
+		Deserialize(reader);
+
+		RandomEngine engine;
+		auto temp_path = StringUtil::Format("%s.tmp-%08x", mapped_path, engine.NextRandomInteger());
+		{
+			auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+			WriteToFile(*handle);
+		}
+		fs.MoveFile(temp_path, mapped_path);
+	}
+
+	// Map the shared copy, which releases the memory of the graph if it was just loaded
+	auto result = index.view(unum::usearch::memory_mapped_file_t(mapped_path.c_str()));
+	if (!result) {
+		throw IOException("Failed to map HNSW index \"%s\" from \"%s\": %s", name, mapped_path,
+		                  result.error.release());
+	}
+
+	// The projection is stored right after the graph
+	if (projection) {
+		auto handle = fs.OpenFile(mapped_path, FileFlags::FILE_FLAGS_READ);
+		handle->Read(projection->matrix.data(), projection->GetSizeInBytes(), index.serialized_length());
+	}
+}
+
+void HNSWIndex::WriteToFile(FileHandle &handle) {
+	index.save_to_stream([&](const void *data, size_t size) {
+		handle.Write(const_cast<void *>(data), size);
+		return true;
+	});
+	if (projection) {
+		handle.Write(projection->matrix.data(), projection->GetSizeInBytes());
+	}
+	handle.Sync();
+}
+
+void HNSWIndex::Export(ClientContext &context, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+
+	auto lock = GetSharedLock();
+	WriteToFile(*handle);
+}
+
+idx_t HNSWIndex::ReadFileSlotBytes(ClientContext &context, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+	const auto file_size = handle->GetFileSize();
+
+	// The header of the graph follows the vectors, which are preceded by their count and size
+	uint32_t matrix_dims[2] = {0, 0};
+	unum::usearch::index_dense_head_buffer_t buffer;
+	if (file_size < sizeof(matrix_dims)) {
+		throw InvalidInputException("File '%s' is not an exported HNSW index", path);
+	}
+	handle->Read(matrix_dims, sizeof(matrix_dims), 0);
+	const auto head_offset = sizeof(matrix_dims) + static_cast<idx_t>(matrix_dims[0]) * matrix_dims[1];
+	if (file_size < head_offset + sizeof(buffer)) {
+		throw InvalidInputException("File '%s' is not an exported HNSW index", path);
+	}
+	handle->Read(buffer, sizeof(buffer), head_offset);
+	if (memcmp(buffer, unum::usearch::default_magic(), strlen(unum::usearch::default_magic())) != 0) {
+		throw InvalidInputException("File '%s' is not an exported HNSW index", path);
+	}
+
+	unum::usearch::index_dense_head_t head {buffer};
+	switch (head.kind_compressed_slot) {
+	case unum::usearch::scalar_kind_t::u32_k:
+		return HNSWGraph::NARROW_SLOT_BYTES;
+	case unum::usearch::scalar_kind_t::u40_k:
+		return HNSWGraph::WIDE_SLOT_BYTES;
+	default:
+		throw InvalidInputException("File '%s' holds an HNSW index with unsupported slots", path);
+	}
+}
+
+void HNSWIndex::Import(ClientContext &context, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+
+	auto lock = GetExclusiveLock();
+
+	// Loading the graph replaces the metric, so remember the one the index was declared with
+	const auto expected_metric = index.metric().metric_kind();
+	const auto expected_dims = index.dimensions();
+	const auto expected_scalar = index.metric().scalar_kind();
+
+	auto result = index.load_from_stream([&](void *data, size_t size) {
+		return static_cast<int64_t>(size) == handle->Read(data, size);
+	});
+	if (!result) {
+		throw InvalidInputException("Failed to load HNSW index from '%s': %s", path, result.error.release());
+	}
+	if (index.dimensions() != expected_dims) {
+		throw InvalidInputException("The HNSW index in '%s' has %llu dimensions, but the index has %llu", path,
+		                            index.dimensions(), expected_dims);
+	}
+	if (index.metric().metric_kind() != expected_metric) {
+		throw InvalidInputException("The HNSW index in '%s' uses the '%s' metric, but the index uses '%s'", path,
+		                            unum::usearch::metric_kind_name(index.metric().metric_kind()),
+		                            unum::usearch::metric_kind_name(expected_metric));
+	}
+	if (index.metric().scalar_kind() != expected_scalar) {
+		throw InvalidInputException("The HNSW index in '%s' stores another type of vectors than the index", path);
+	}
+
+	// The projection is stored right after the graph
+	if (projection) {
+		const auto projection_size = static_cast<int64_t>(projection->GetSizeInBytes());
+		if (handle->Read(projection->matrix.data(), projection->GetSizeInBytes()) != projection_size) {
+			throw InvalidInputException("The HNSW index in '%s' lacks the projection of the index", path);
+		}
+	}
+
+	// Loading the graph picks the best kernels again, so pin them after it
+	ConfigureMetric(simd_capabilities);
+
+	index_size = index.size();
+	is_dirty = true;
+}
+
+void HNSWIndex::CopyFrom(HNSWIndex &source) {
+	auto source_lock = source.GetSharedLock();
+	auto lock = GetExclusiveLock();
+
+	auto error = source.index.copy_to(index);
+	if (error) {
+		throw InternalException("Failed to copy HNSW index \"%s\": %s", source.name, error.release());
+	}
+	if (projection) {
+		projection->matrix = source.projection->matrix;
+	}
+
+	// Copying the graph copies the kernels of the source as well, so pin ours again
+	ConfigureMetric(simd_capabilities);
+
+	index_size = index.size();
+	is_dirty = true;
+}
+
+void HNSWIndex::RemapRowIds(const vector<row_t> &old_row_ids, const vector<row_t> &new_row_ids) {
+	D_ASSERT(old_row_ids.size() == new_row_ids.size());
+	auto lock = GetExclusiveLock();
+
+	auto error = index.transform_keys([&](row_t row_id) {
+		auto entry = std::lower_bound(old_row_ids.begin(), old_row_ids.end(), row_id);
+		D_ASSERT(entry != old_row_ids.end() && *entry == row_id);
+		return new_row_ids[NumericCast<idx_t>(entry - old_row_ids.begin())];
+	});
+	if (error) {
+		throw InternalException("Failed to remap the row ids of HNSW index \"%s\": %s", name, error.release());
+	}
+	is_dirty = true;
+}
+
+case_insensitive_map_t<Value> HNSWIndex::GetEntryOptions(IndexCatalogEntry &entry) {
+	lock_guard<mutex> guard(entry_options_lock);
+	return entry.options;
+}
+
+void HNSWIndex::SetEntryOptions(IndexCatalogEntry &entry, case_insensitive_map_t<Value> options) {
+	lock_guard<mutex> guard(entry_options_lock);
+	entry.options = std::move(options);
+}
+
+optional_idx HNSWIndex::FindMismatchedVector(const float *vectors, const row_t *row_ids, idx_t count) {
+	const auto array_size = GetVectorSize();
+	const auto dims = index.dimensions();
+	auto stored = make_unsafe_uniq_array<float>(dims);
+	unsafe_unique_array<float> projected;
+	if (projection) {
+		projected = make_unsafe_uniq_array<float>(dims);
+	}
+
+	auto lock = GetSharedLock();
+	for (idx_t i = 0; i < count; i++) {
+		// The graph holds the projected vectors, or the leading dimensions if it is searched on fewer
+		const float *vec_ptr = vectors + i * array_size;
+		if (projection) {
+			projection->Project(vec_ptr, projected.get());
+			vec_ptr = projected.get();
+		}
+		if (!index.get(row_ids[i], stored.get()) ||
+		    memcmp(stored.get(), vec_ptr, dims * sizeof(float)) != 0) {
+			return i;
+		}
+	}
+	return optional_idx();
+}
+
+void HNSWIndex::ConfigureMetric(uint32_t capabilities) {
+	auto &current = index.metric();
+	if (capabilities == HNSWSimd::ALL_CAPABILITIES) {
+		// Without a target, the metric may also abandon distance computations early
+		index.change_metric(unum::usearch::metric_punned_t::builtin(current.dimensions(), current.metric_kind(),
+		                                                            current.scalar_kind()));
+	} else {
+		index.change_metric(unum::usearch::metric_punned_t::builtin_restricted(
+		    current.dimensions(), current.metric_kind(), current.scalar_kind(), capabilities));
+	}
+	simd_capabilities = capabilities;
+}
+
+void HNSWIndex::ApplySimdTarget() {
+	auto capabilities = HNSWSimd::GetConfiguredCapabilities(db.GetDatabase());
+	if (capabilities == simd_capabilities) {
+		return;
+	}
+	auto lock = GetExclusiveLock();
+	if (capabilities != simd_capabilities) {
+		ConfigureMetric(capabilities);
+	}
 }
 
 idx_t HNSWIndex::GetVectorSize() const {
+	return vector_size;
+}
+
+idx_t HNSWIndex::GetSearchDimensions() const {
 	return index.dimensions();
 }
 
+bool HNSWIndex::HasProjection() const {
+	return projection != nullptr;
+}
+
+void HNSWIndex::ProjectVector(const float *vec, float *result) const {
+	D_ASSERT(projection);
+	projection->Project(vec, result);
+}
+
+void HNSWIndex::LearnProjection(const float *sample, idx_t count) {
+	if (!projection || !learn_projection) {
+		return;
+	}
+	// The covariance preserves euclidean distances, the uncentered second moment preserves inner products
+	auto center = index.metric().metric_kind() == unum::usearch::metric_kind_t::l2sq_k;
+	RandomEngine engine;
+	projection->InitializePCA(sample, count, center, engine);
+}
+
 string HNSWIndex::GetMetric() const {
 	switch (index.metric().metric_kind()) {
 	case unum::usearch::metric_kind_t::l2sq_k:
@@ -249,6 +486,203 @@ bool HNSWIndex::MatchesDistanceFunction(const string &distance_function_name) co
 	return false;
 }
 
+bool HNSWIndex::MatchesExpression(const Expression &expr) const {
+	// The bound expressions reference the columns of the table by their storage index as well
+	return bound_expressions[0]->Equals(expr);
+}
+
+void HNSWIndex::VerifyOptions(const case_insensitive_map_t<Value> &options, const LogicalType &key_type,
+                              bool is_column_ref) {
+	for (auto &option : options) {
+		auto &k = option.first;
+		auto &v = option.second;
+		if (StringUtil::CIEquals(k, "metric")) {
+			if (v.type() != LogicalType::VARCHAR) {
+				throw BinderException("HNSW index 'metric' must be a string");
+			}
+			auto metric = v.GetValue<string>();
+			if (HNSWIndex::METRIC_KIND_MAP.find(metric) == HNSWIndex::METRIC_KIND_MAP.end()) {
+				vector<string> allowed_metrics;
+				for (auto &entry : HNSWIndex::METRIC_KIND_MAP) {
+					allowed_metrics.push_back(StringUtil::Format("'%s'", entry.first));
+				}
+				throw BinderException("HNSW index 'metric' must be one of: %s",
+				                      StringUtil::Join(allowed_metrics, ", "));
+			}
+		} else if (StringUtil::CIEquals(k, "ef_construction")) {
+			if (v.type() != LogicalType::INTEGER) {
+				throw BinderException("HNSW index 'ef_construction' must be an integer");
+			}
+			if (v.GetValue<int32_t>() < 1) {
+				throw BinderException("HNSW index 'ef_construction' must be at least 1");
+			}
+		} else if (StringUtil::CIEquals(k, "ef_search")) {
+			if (v.type() != LogicalType::INTEGER) {
+				throw BinderException("HNSW index 'ef_search' must be an integer");
+			}
+			if (v.GetValue<int32_t>() < 1) {
+				throw BinderException("HNSW index 'ef_search' must be at least 1");
+			}
+		} else if (StringUtil::CIEquals(k, "M")) {
+			if (v.type() != LogicalType::INTEGER) {
+				throw BinderException("HNSW index 'M' must be an integer");
+			}
+			if (v.GetValue<int32_t>() < 2) {
+				throw BinderException("HNSW index 'M' must be at least 2");
+			}
+		} else if (StringUtil::CIEquals(k, "M0")) {
+			if (v.type() != LogicalType::INTEGER) {
+				throw BinderException("HNSW index 'M0' must be an integer");
+			}
+			if (v.GetValue<int32_t>() < 2) {
+				throw BinderException("HNSW index 'M0' must be at least 2");
+			}
+		} else if (StringUtil::CIEquals(k, "search_dims")) {
+			if (v.type() != LogicalType::INTEGER) {
+				throw BinderException("HNSW index 'search_dims' must be an integer");
+			}
+			if (v.GetValue<int32_t>() < 1) {
+				throw BinderException("HNSW index 'search_dims' must be at least 1");
+			}
+		} else if (StringUtil::CIEquals(k, "projection")) {
+			if (v.type() != LogicalType::VARCHAR) {
+				throw BinderException("HNSW index 'projection' must be a string");
+			}
+			if (HNSWProjection::KINDS.find(v.GetValue<string>()) == HNSWProjection::KINDS.end()) {
+				vector<string> allowed_kinds;
+				for (auto &entry : HNSWProjection::KINDS) {
+					allowed_kinds.push_back(StringUtil::Format("'%s'", entry));
+				}
+				throw BinderException("HNSW index 'projection' must be one of: %s",
+				                      StringUtil::Join(allowed_kinds, ", "));
+			}
+		} else if (StringUtil::CIEquals(k, "projection_dims")) {
+			if (v.type() != LogicalType::INTEGER) {
+				throw BinderException("HNSW index 'projection_dims' must be an integer");
+			}
+			if (v.GetValue<int32_t>() < 1) {
+				throw BinderException("HNSW index 'projection_dims' must be at least 1");
+			}
+		} else if (StringUtil::CIEquals(k, "rerank")) {
+			if (v.type() != LogicalType::BOOLEAN) {
+				throw BinderException("HNSW index 'rerank' must be a boolean");
+			}
+		} else if (StringUtil::CIEquals(k, "build_order")) {
+			if (v.type() != LogicalType::VARCHAR) {
+				throw BinderException("HNSW index 'build_order' must be a string");
+			}
+			if (HNSWBuildOrder::KINDS.find(v.GetValue<string>()) == HNSWBuildOrder::KINDS.end()) {
+				vector<string> allowed_orders;
+				for (auto &entry : HNSWBuildOrder::KINDS) {
+					allowed_orders.push_back(StringUtil::Format("'%s'", entry));
+				}
+				throw BinderException("HNSW index 'build_order' must be one of: %s",
+				                      StringUtil::Join(allowed_orders, ", "));
+			}
+		} else if (StringUtil::CIEquals(k, "hierarchical_build")) {
+			if (v.type() != LogicalType::BOOLEAN) {
+				throw BinderException("HNSW index 'hierarchical_build' must be a boolean");
+			}
+		} else if (StringUtil::CIEquals(k, "max_build_memory")) {
+			if (v.type() != LogicalType::VARCHAR) {
+				throw BinderException("HNSW index 'max_build_memory' must be a string, e.g. '4GB'");
+			}
+			// Throws if the value is not a valid memory size
+			DBConfig::ParseMemoryLimit(v.GetValue<string>());
+		} else if (StringUtil::CIEquals(k, "slot_bytes")) {
+			if (v.type() != LogicalType::INTEGER) {
+				throw BinderException("HNSW index 'slot_bytes' must be an integer");
+			}
+			auto slot_bytes = v.GetValue<int32_t>();
+			if (slot_bytes != static_cast<int32_t>(HNSWGraph::NARROW_SLOT_BYTES) &&
+			    slot_bytes != static_cast<int32_t>(HNSWGraph::WIDE_SLOT_BYTES)) {
+				throw BinderException("HNSW index 'slot_bytes' must be %llu or %llu", HNSWGraph::NARROW_SLOT_BYTES,
+				                      HNSWGraph::WIDE_SLOT_BYTES);
+			}
+		} else if (StringUtil::CIEquals(k, "compress_neighbors")) {
+			if (v.type() != LogicalType::BOOLEAN) {
+				throw BinderException("HNSW index 'compress_neighbors' must be a boolean");
+			}
+		} else if (StringUtil::CIEquals(k, "huge_pages")) {
+			if (v.type() != LogicalType::VARCHAR) {
+				throw BinderException("HNSW index 'huge_pages' must be a string");
+			}
+			if (HNSWIndex::HUGE_PAGES_MAP.find(v.GetValue<string>()) == HNSWIndex::HUGE_PAGES_MAP.end()) {
+				vector<string> allowed_modes;
+				for (auto &entry : HNSWIndex::HUGE_PAGES_MAP) {
+					allowed_modes.push_back(StringUtil::Format("'%s'", entry.first));
+				}
+				throw BinderException("HNSW index 'huge_pages' must be one of: %s",
+				                      StringUtil::Join(allowed_modes, ", "));
+			}
+		} else if (StringUtil::CIEquals(k, "from_file")) {
+			if (v.type() != LogicalType::VARCHAR) {
+				throw BinderException("HNSW index 'from_file' must be a string");
+			}
+		} else if (StringUtil::CIEquals(k, "from_index")) {
+			if (v.type() != LogicalType::VARCHAR) {
+				throw BinderException("HNSW index 'from_index' must be a string");
+			}
+			// The copied graph was built with the options of the source index, which the copy takes over
+			if (options.size() != 1) {
+				throw BinderException("HNSW index 'from_index' cannot be combined with other options");
+			}
+		} else {
+			throw BinderException("Unknown option for HNSW index: '%s'", k);
+		}
+	}
+
+
+	// Verify the search dimensions against the vector size
+	auto search_dims_opt = options.find("search_dims");
+	if (search_dims_opt != options.end()) {
+		auto search_dims = static_cast<idx_t>(search_dims_opt->second.GetValue<int32_t>());
+		if (search_dims > ArrayType::GetSize(key_type)) {
+			throw BinderException("HNSW index 'search_dims' must not exceed the vector size (%llu)",
+			                      ArrayType::GetSize(key_type));
+		}
+		// Refinement fetches the full vectors from the table, so the index has to be over a plain column
+		if (!is_column_ref) {
+			throw BinderException("HNSW index 'search_dims' can only be used on indexes over a single column");
+		}
+		// The full vectors are compared as floats during refinement
+		if (ArrayType::GetChildType(key_type).id() != LogicalTypeId::FLOAT) {
+			throw BinderException("HNSW index 'search_dims' can only be used on indexes over FLOAT[N] vectors");
+		}
+	}
+
+	// Verify the projection options
+	auto projection_opt = options.find("projection");
+	auto projection_dims_opt = options.find("projection_dims");
+	auto rerank_opt = options.find("rerank");
+	if (projection_opt == options.end()) {
+		if (projection_dims_opt != options.end() || rerank_opt != options.end()) {
+			throw BinderException("HNSW index 'projection_dims' and 'rerank' require 'projection' to be set");
+		}
+	} else {
+		if (search_dims_opt != options.end()) {
+			throw BinderException("HNSW index 'projection' cannot be combined with 'search_dims'");
+		}
+		if (projection_dims_opt == options.end()) {
+			throw BinderException("HNSW index 'projection' requires 'projection_dims' to be set");
+		}
+		auto projection_dims = static_cast<idx_t>(projection_dims_opt->second.GetValue<int32_t>());
+		if (projection_dims > ArrayType::GetSize(key_type)) {
+			throw BinderException("HNSW index 'projection_dims' must not exceed the vector size (%llu)",
+			                      ArrayType::GetSize(key_type));
+		}
+		// The projection is computed on floats, like the refinement
+		if (ArrayType::GetChildType(key_type).id() != LogicalTypeId::FLOAT) {
+			throw BinderException("HNSW index 'projection' can only be used on indexes over FLOAT[N] vectors");
+		}
+		// Re-ranking fetches the original vectors from the table, so the index has to be over a plain column
+		auto rerank = rerank_opt == options.end() || rerank_opt->second.GetValue<bool>();
+		if (rerank && !is_column_ref) {
+			throw BinderException("HNSW index 'rerank' can only be used on indexes over a single column");
+		}
+	}
+}
+
 const case_insensitive_map_t<unum::usearch::metric_kind_t> HNSWIndex::METRIC_KIND_MAP = {
     {"l2sq", unum::usearch::metric_kind_t::l2sq_k},
     {"cosine", unum::usearch::metric_kind_t::cos_k},
@@ -264,6 +698,12 @@ const case_insensitive_map_t<unum::usearch::metric_kind_t> HNSWIndex::METRIC_KIN
      */
 };
 
+const case_insensitive_map_t<unum::usearch::huge_pages_t> HNSWIndex::HUGE_PAGES_MAP = {
+    {"none", unum::usearch::huge_pages_t::none_k},
+    {"transparent", unum::usearch::huge_pages_t::transparent_k},
+    {"explicit", unum::usearch::huge_pages_t::explicit_k},
+};
+
 const unordered_map<uint8_t, unum::usearch::scalar_kind_t> HNSWIndex::SCALAR_KIND_MAP = {
     {static_cast<uint8_t>(LogicalTypeId::FLOAT), unum::usearch::scalar_kind_t::f32_k},
     {static_cast<uint8_t>(LogicalTypeId::DOUBLE), unum::usearch::scalar_kind_t::f64_k},
@@ -276,14 +716,48 @@ const unordered_map<uint8_t, unum::usearch::scalar_kind_t> HNSWIndex::SCALAR_KIN
     {static_cast<uint8_t>(LogicalTypeId::UINTEGER), unum::usearch::scalar_kind_t::u32_k},
     {static_cast<uint8_t>(LogicalTypeId::UBIGINT), unum::usearch::scalar_kind_t::u64_k}};
 
-unique_ptr<HNSWIndexStats> HNSWIndex::GetStats() {
+unique_ptr<StorageLockKey> HNSWIndex::GetSharedLock() {
+	auto start = std::chrono::steady_clock::now();
+	auto lock = rwlock.GetSharedLock();
+	auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	shared_lock_acquisitions++;
+	shared_lock_wait_ns += static_cast<idx_t>(waited.count());
+	return lock;
+}
+
+unique_ptr<StorageLockKey> HNSWIndex::GetExclusiveLock() {
+	auto start = std::chrono::steady_clock::now();
 	auto lock = rwlock.GetExclusiveLock();
+	auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	exclusive_lock_acquisitions++;
+	exclusive_lock_wait_ns += static_cast<idx_t>(waited.count());
+	return lock;
+}
+
+unique_ptr<HNSWIndexStats> HNSWIndex::GetStats() {
 	auto result = make_uniq<HNSWIndexStats>();
+	// Read the lock counters before taking the lock ourselves
+	result->lock_stats.shared_acquisitions = shared_lock_acquisitions.load();
+	result->lock_stats.shared_wait_us = shared_lock_wait_ns.load() / 1000;
+	result->lock_stats.exclusive_acquisitions = exclusive_lock_acquisitions.load();
+	result->lock_stats.exclusive_wait_us = exclusive_lock_wait_ns.load() / 1000;
+	result->warmups = warmups.load();
+
+	auto lock = GetExclusiveLock();
 
 	result->max_level = index.max_level();
 	result->count = index.size();
 	result->capacity = index.capacity();
 	result->approx_size = index.memory_usage();
+	result->isa = index.metric().isa_name();
+	result->slot_bytes = index.slot_bytes();
+	result->ef_search = index.expansion_search();
+	const auto backing = index.huge_pages_backing();
+	for (auto &entry : HUGE_PAGES_MAP) {
+		if (entry.second == backing) {
+			result->huge_pages = entry.first;
+		}
+	}
 
 	for (idx_t i = 0; i < index.max_level(); i++) {
 		result->level_stats.push_back(index.stats(i));
@@ -292,41 +766,355 @@ unique_ptr<HNSWIndexStats> HNSWIndex::GetStats() {
 	return result;
 }
 
-// Scan State
-struct HNSWIndexScanState : public IndexScanState {
-	idx_t current_row = 0;
-	idx_t total_rows = 0;
-	unique_array<row_t> row_ids = nullptr;
-};
-
-unique_ptr<IndexScanState> HNSWIndex::InitializeScan(float *query_vector, idx_t limit, ClientContext &context) {
-	auto state = make_uniq<HNSWIndexScanState>();
-
-	// Try to get the ef_search parameter from the database or use the default value
-	auto ef_search = index.expansion_search();
-
+// The ef_search set with hnsw_ef_search for the client, if any
+static optional_idx GetEfSearchSetting(ClientContext &context) {
 	Value hnsw_ef_search_opt;
 	if (context.TryGetCurrentSetting("hnsw_ef_search", hnsw_ef_search_opt)) {
 		if (!hnsw_ef_search_opt.IsNull() && hnsw_ef_search_opt.type() == LogicalType::BIGINT) {
 			auto val = hnsw_ef_search_opt.GetValue<int64_t>();
 			if (val > 0) {
-				ef_search = static_cast<idx_t>(val);
+				return static_cast<idx_t>(val);
 			}
 		}
 	}
+	return optional_idx();
+}
 
-	// Acquire a shared lock to search the index
-	auto lock = rwlock.GetSharedLock();
-	auto search_result = index.ef_search(query_vector, limit, ef_search);
+idx_t HNSWIndex::GetRefineFactor(ClientContext &context) {
+	idx_t refine_factor = DEFAULT_REFINE_FACTOR;
 
-	state->current_row = 0;
-	state->total_rows = search_result.size();
-	state->row_ids = make_uniq_array<row_t>(search_result.size());
+	Value hnsw_refine_factor_opt;
+	if (context.TryGetCurrentSetting("hnsw_refine_factor", hnsw_refine_factor_opt)) {
+		if (!hnsw_refine_factor_opt.IsNull() && hnsw_refine_factor_opt.type() == LogicalType::BIGINT) {
+			auto val = hnsw_refine_factor_opt.GetValue<int64_t>();
+			if (val > 0) {
+				refine_factor = static_cast<idx_t>(val);
+			}
+		}
+	}
+	return refine_factor;
+}
+
+// Add the rows among "row_ids" that are not visible to the transaction of the client to "invisible", returning how
+// many were added
+static idx_t CollectInvisibleRows(DuckTableEntry &table, ClientContext &context, const row_t *row_ids, idx_t count,
+                                  unordered_set<row_t> &invisible) {
+	auto &storage = table.GetStorage();
+	auto &transaction = DuckTransaction::Get(context, table.catalog);
+
+	// Fetching the row ids alone checks the versions of the rows, skipping the ones that are not visible
+	vector<storage_t> fetch_ids = {COLUMN_IDENTIFIER};
+	DataChunk fetch_chunk;
+	fetch_chunk.Initialize(Allocator::DefaultAllocator(), {LogicalType::ROW_TYPE});
+	ColumnFetchState fetch_state;
+	Vector row_id_vec(LogicalType::ROW_TYPE);
+	auto row_id_data = FlatVector::GetData<row_t>(row_id_vec);
+
+	idx_t added = 0;
+	for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+		const auto batch_count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+		memcpy(row_id_data, row_ids + offset, batch_count * sizeof(row_t));
+
+		fetch_chunk.Reset();
+		storage.Fetch(transaction, fetch_chunk, fetch_ids, row_id_vec, batch_count, fetch_state);
+
+		// The fetched rows keep their order, so the ones that are missing were skipped
+		auto fetched_row_ids = FlatVector::GetData<row_t>(fetch_chunk.data[0]);
+		idx_t fetched_idx = 0;
+		for (idx_t i = 0; i < batch_count; i++) {
+			if (fetched_idx < fetch_chunk.size() && fetched_row_ids[fetched_idx] == row_id_data[i]) {
+				fetched_idx++;
+			} else if (invisible.insert(row_id_data[i]).second) {
+				added++;
+			}
+		}
+	}
+	return added;
+}
+
+// Whether the graph may hold rows that the transaction of the client can't see: rows committed after it started, rows
+// deleted by a transaction that committed before it started that are not cleaned up yet, or rows it deleted itself
+static bool MayHaveInvisibleRows(DuckTableEntry &table, ClientContext &context) {
+	auto &transaction = DuckTransaction::Get(context, table.catalog);
+	if (transaction.ChangesMade()) {
+		return true;
+	}
+	// Deletes are cleaned up, i.e. removed from the graph, once no transaction that started before they committed is
+	// active anymore. So if nothing was committed since we started and no older transaction is active, every row in
+	// the graph is visible to us.
+	auto &manager = DuckTransactionManager::Get(table.catalog.GetAttached());
+	return manager.GetLastCommit() >= transaction.start_time || manager.LowestActiveStart() < transaction.start_time;
+}
+
+// The graph is searched at most this many times per scan to replace rows that are not visible to the scan. Each
+// search skips all invisible rows found so far, so this is only reached when many transactions changed the table
+// concurrently, in which case the scan returns the visible rows it has found
+static constexpr const idx_t MAX_VISIBILITY_SEARCHES = 4;
+
+void HNSWIndex::SearchGraph(HNSWIndexScanState &state, const float *query_vector, idx_t limit) {
+	// Acquire a shared lock to search the index. A rebuild swaps the graph together with its projection, its default
+	// ef_search and whether it needs refinement under the exclusive lock, so read all of them here.
+	auto lock = GetSharedLock();
+
+	// Project the query into the space of the graph
+	unsafe_unique_array<float> projected_query;
+	if (projection) {
+		projected_query = make_unsafe_uniq_array<float>(projection->output_dims);
+		projection->Project(query_vector, projected_query.get());
+		query_vector = projected_query.get();
+	}
 
-	search_result.dump_to(state->row_ids.get());
+	// When refining, search for more candidates than requested, the closest ones are picked afterwards
+	state.requires_refinement = requires_refinement;
+	state.search_limit = requires_refinement ? limit * state.refine_factor : limit;
+
+	auto ef_search = state.ef_search.IsValid() ? state.ef_search.GetIndex() : index.expansion_search();
+	ef_search = MaxValue(ef_search, state.search_limit);
+	HNSWGraph::search_result_t search_result;
+	if (state.invisible.empty()) {
+		search_result = index.ef_search(query_vector, state.search_limit, ef_search);
+	} else {
+		search_result = index.filtered_ef_search(query_vector, state.search_limit, ef_search, [&](row_t key) {
+			return state.invisible.find(key) == state.invisible.end();
+		});
+	}
+	state.searches++;
+
+	state.current_row = 0;
+	state.total_rows = search_result.count;
+	state.row_ids = std::move(search_result.keys);
+	state.distances = std::move(search_result.distances);
+}
+
+unique_ptr<IndexScanState> HNSWIndex::InitializeScan(DuckTableEntry &table, float *query_vector, idx_t limit,
+                                                     ClientContext &context, optional_idx ef_search_override) {
+	auto state = make_uniq<HNSWIndexScanState>();
+
+	// An ef_search given for the query takes precedence over the hnsw_ef_search setting, which in turn takes
+	// precedence over the default of the index
+	state->ef_search = ef_search_override.IsValid() ? ef_search_override : GetEfSearchSetting(context);
+	state->refine_factor = GetRefineFactor(context);
+	SearchGraph(*state, query_vector, limit);
+
+	// The graph holds the rows of all transactions, so it may return rows that are not visible to us. Search again
+	// without them, so that we still find "limit" rows if the table has them, rather than dropping them from the
+	// results when they are fetched. Refining the scan fetches every candidate anyway, so it checks them then.
+	if (state->requires_refinement || !MayHaveInvisibleRows(table, context)) {
+		return std::move(state);
+	}
+	while (true) {
+		auto added = CollectInvisibleRows(table, context, state->row_ids.get(), state->total_rows, state->invisible);
+		if (added == 0 || state->total_rows < state->search_limit || state->searches >= MAX_VISIBILITY_SEARCHES) {
+			// Either all rows are visible, the graph has no other rows to offer, or we gave up on replacing them
+			break;
+		}
+		SearchGraph(*state, query_vector, limit);
+	}
+
+	// Leave out the rows that are not visible to us
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < state->total_rows; i++) {
+		if (state->invisible.find(state->row_ids[i]) != state->invisible.end()) {
+			continue;
+		}
+		state->row_ids[result_count] = state->row_ids[i];
+		state->distances[result_count] = state->distances[i];
+		result_count++;
+	}
+	state->total_rows = result_count;
 	return std::move(state);
 }
 
+void HNSWIndex::RefineScan(IndexScanState &state, DuckTableEntry &table, ClientContext &context,
+                           const float *query_vector, idx_t limit) {
+	auto &scan_state = state.Cast<HNSWIndexScanState>();
+	if (!scan_state.requires_refinement) {
+		return;
+	}
+	auto &storage = table.GetStorage();
+	auto &transaction = DuckTransaction::Get(context, table.catalog);
+
+	// A rebuild replaces the metric under the exclusive lock, so copy it under the shared lock
+	unum::usearch::metric_punned_t metric;
+	{
+		auto lock = GetSharedLock();
+		metric = refine_metric;
+	}
+
+	// Fetch the indexed column together with the row ids, rows that are not visible to us are skipped by the fetch
+	D_ASSERT(column_ids.size() == 1);
+	vector<storage_t> fetch_ids = {column_ids[0], COLUMN_IDENTIFIER};
+	DataChunk fetch_chunk;
+	fetch_chunk.Initialize(Allocator::DefaultAllocator(), {logical_types[0], LogicalType::ROW_TYPE});
+	ColumnFetchState fetch_state;
+	Vector row_id_vec(LogicalType::ROW_TYPE);
+	auto row_id_data = FlatVector::GetData<row_t>(row_id_vec);
+
+	// Compute the distance to the full vector of every candidate
+	vector<pair<float, row_t>> candidates;
+	auto query_ptr = reinterpret_cast<const unum::usearch::byte_t *>(query_vector);
+
+	while (true) {
+		candidates.clear();
+		candidates.reserve(scan_state.total_rows);
+		idx_t added = 0;
+		for (idx_t offset = 0; offset < scan_state.total_rows; offset += STANDARD_VECTOR_SIZE) {
+			const auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, scan_state.total_rows - offset);
+			memcpy(row_id_data, scan_state.row_ids.get() + offset, count * sizeof(row_t));
+
+			fetch_chunk.Reset();
+			storage.Fetch(transaction, fetch_chunk, fetch_ids, row_id_vec, count, fetch_state);
+
+			auto &vec_vec = fetch_chunk.data[0];
+			auto vec_child_data = FlatVector::GetData<float>(ArrayVector::GetEntry(vec_vec));
+			auto fetched_row_ids = FlatVector::GetData<row_t>(fetch_chunk.data[1]);
+
+			// The fetched rows keep their order, so the ones that are missing are not visible to us
+			idx_t fetched_idx = 0;
+			for (idx_t i = 0; i < count; i++) {
+				if (fetched_idx >= fetch_chunk.size() || fetched_row_ids[fetched_idx] != row_id_data[i]) {
+					if (scan_state.invisible.insert(row_id_data[i]).second) {
+						added++;
+					}
+					continue;
+				}
+				if (!FlatVector::IsNull(vec_vec, fetched_idx)) {
+					auto vec_ptr =
+					    reinterpret_cast<const unum::usearch::byte_t *>(vec_child_data + fetched_idx * vector_size);
+					candidates.emplace_back(metric(query_ptr, vec_ptr), fetched_row_ids[fetched_idx]);
+				}
+				fetched_idx++;
+			}
+		}
+
+		// Like an unrefined scan, search again without the rows that are not visible to us
+		if (added == 0 || scan_state.total_rows < scan_state.search_limit ||
+		    scan_state.searches >= MAX_VISIBILITY_SEARCHES) {
+			break;
+		}
+		SearchGraph(scan_state, query_vector, limit);
+	}
+
+	// Keep the closest candidates
+	auto result_count = MinValue<idx_t>(limit, candidates.size());
+	std::partial_sort(candidates.begin(), candidates.begin() + static_cast<ptrdiff_t>(result_count), candidates.end());
+
+	scan_state.current_row = 0;
+	scan_state.total_rows = result_count;
+	scan_state.row_ids = make_uniq_array<row_t>(result_count);
+	scan_state.distances = make_uniq_array<float>(result_count);
+	for (idx_t i = 0; i < result_count; i++) {
+		scan_state.row_ids[i] = candidates[i].second;
+		scan_state.distances[i] = candidates[i].first;
+	}
+}
+
+// Fetching a vector from the table to refine a scan costs about as much as comparing this many vectors of the same
+// size in the graph, since the rows are read at random
+static constexpr const double REFINE_FETCH_WEIGHT = 4;
+
+HNSWScanEstimate HNSWIndex::EstimateScan(idx_t limit, ClientContext &context) {
+	auto refine_factor = GetRefineFactor(context);
+	auto ef_search_setting = GetEfSearchSetting(context);
+
+	auto lock = GetSharedLock();
+	auto search_limit = requires_refinement ? limit * refine_factor : limit;
+	auto &config = index.config();
+	auto ef_search = ef_search_setting.IsValid() ? ef_search_setting.GetIndex() : index.expansion_search();
+	ef_search = MaxValue(ef_search, search_limit);
+
+	// A search descends greedily through the upper levels, and then expands "ef_search" candidates on the base level,
+	// comparing the query with all neighbours of each
+	auto comparisons = index.max_level() * config.connectivity + ef_search * config.connectivity_base;
+
+	HNSWScanEstimate result;
+	result.cost = static_cast<double>(comparisons) * static_cast<double>(index.bytes_per_vector());
+	if (requires_refinement) {
+		result.cost += static_cast<double>(search_limit * vector_size * sizeof(float)) * REFINE_FETCH_WEIGHT;
+	}
+	result.quality = static_cast<double>(ef_search * config.connectivity_base) *
+	                 static_cast<double>(GetSearchDimensions()) / static_cast<double>(vector_size);
+	return result;
+}
+
+unique_ptr<IndexScanState> HNSWIndex::InitializeExactScan(DuckTableEntry &table, ClientContext &context,
+                                                          const float *query_vector, idx_t limit) {
+	if (unbound_expressions[0]->type != ExpressionType::BOUND_COLUMN_REF) {
+		throw InvalidInputException("Exact searches are not supported on HNSW index '%s', which is not over a column",
+		                            name);
+	}
+	auto &storage = table.GetStorage();
+	auto &transaction = DuckTransaction::Get(context, table.catalog);
+
+	// Scan the indexed column together with the row ids of all rows that are visible to us
+	D_ASSERT(column_ids.size() == 1);
+	vector<column_t> scan_ids = {column_ids[0], COLUMN_IDENTIFIER_ROW_ID};
+	TableScanState table_scan_state;
+	storage.InitializeScan(transaction, table_scan_state, scan_ids);
+	DataChunk scan_chunk;
+	scan_chunk.Initialize(Allocator::Get(context), {logical_types[0], LogicalType::ROW_TYPE});
+
+	// A rebuild replaces the metric under the exclusive lock, so copy it under the shared lock
+	unum::usearch::metric_punned_t metric;
+	{
+		auto lock = GetSharedLock();
+		metric = refine_metric;
+	}
+
+	// Keep the closest rows in a max-heap on their distance to the query
+	vector<pair<float, row_t>> closest;
+	auto query_ptr = reinterpret_cast<const unum::usearch::byte_t *>(query_vector);
+
+	while (true) {
+		scan_chunk.Reset();
+		storage.Scan(transaction, scan_chunk, table_scan_state);
+		if (scan_chunk.size() == 0) {
+			break;
+		}
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		scan_chunk.Flatten();
+
+		auto &vec_vec = scan_chunk.data[0];
+		auto vec_child_data = FlatVector::GetData<float>(ArrayVector::GetEntry(vec_vec));
+		auto row_id_data = FlatVector::GetData<row_t>(scan_chunk.data[1]);
+		for (idx_t i = 0; i < scan_chunk.size(); i++) {
+			// Rows appended by our own transaction can't be fetched by their row id, and are not in the index either
+			if (FlatVector::IsNull(vec_vec, i) || row_id_data[i] >= MAX_ROW_ID) {
+				continue;
+			}
+			auto vec_ptr = reinterpret_cast<const unum::usearch::byte_t *>(vec_child_data + i * vector_size);
+			auto distance = static_cast<float>(metric(query_ptr, vec_ptr));
+			if (closest.size() < limit) {
+				closest.emplace_back(distance, row_id_data[i]);
+				std::push_heap(closest.begin(), closest.end());
+			} else if (distance < closest.front().first) {
+				std::pop_heap(closest.begin(), closest.end());
+				closest.back() = make_pair(distance, row_id_data[i]);
+				std::push_heap(closest.begin(), closest.end());
+			}
+		}
+	}
+	std::sort_heap(closest.begin(), closest.end());
+
+	auto state = make_uniq<HNSWIndexScanState>();
+	state->current_row = 0;
+	state->total_rows = closest.size();
+	state->row_ids = make_uniq_array<row_t>(closest.size());
+	state->distances = make_uniq_array<float>(closest.size());
+	for (idx_t i = 0; i < closest.size(); i++) {
+		state->row_ids[i] = closest[i].second;
+		state->distances[i] = closest[i].first;
+	}
+	return std::move(state);
+}
+
+void HNSWIndex::SetSearchExpansion(idx_t ef_search) {
+	auto lock = GetExclusiveLock();
+	index.change_expansion_search(ef_search);
+}
+
 idx_t HNSWIndex::Scan(IndexScanState &state, Vector &result) {
 	auto &scan_state = state.Cast<HNSWIndexScanState>();
 
@@ -344,7 +1132,7 @@ idx_t HNSWIndex::Scan(IndexScanState &state, Vector &result) {
 
 void HNSWIndex::CommitDrop(IndexLock &index_lock) {
 	// Acquire an exclusive lock to drop the index
-	auto lock = rwlock.GetExclusiveLock();
+	auto lock = GetExclusiveLock();
 
 	index.reset();
 	index_size = 0;
@@ -353,7 +1141,7 @@ void HNSWIndex::CommitDrop(IndexLock &index_lock) {
 	root_block_ptr.Clear();
 }
 
-void HNSWIndex::Construct(DataChunk &input, Vector &row_ids, idx_t thread_idx) {
+void HNSWIndex::Construct(DataChunk &input, Vector &row_ids, idx_t thread_idx, idx_t max_capacity) {
 	D_ASSERT(row_ids.GetType().InternalType() == ROW_TYPE);
 	D_ASSERT(logical_types[0] == input.data[0].GetType());
 
@@ -375,7 +1163,7 @@ void HNSWIndex::Construct(DataChunk &input, Vector &row_ids, idx_t thread_idx) {
 	// locking exclusively when checking
 	bool needs_resize = false;
 	{
-		auto lock = rwlock.GetSharedLock();
+		auto lock = GetSharedLock();
 		if (index_size.fetch_add(count) + count > index.capacity()) {
 			needs_resize = true;
 		}
@@ -383,44 +1171,219 @@ void HNSWIndex::Construct(DataChunk &input, Vector &row_ids, idx_t thread_idx) {
 
 	// We need to "upgrade" the lock to exclusive to resize the index
 	if (needs_resize) {
-		auto lock = rwlock.GetExclusiveLock();
+		auto lock = GetExclusiveLock();
 		// Do we still need to resize?
 		// Another thread might have resized it already
 		auto size = index_size.load();
+		if (size > index.max_size()) {
+			index_size -= count;
+			throw InvalidInputException(
+			    "HNSW index '%s' cannot hold more than %llu vectors, recreate it with slot_bytes = %llu", name,
+			    index.max_size(), HNSWGraph::WIDE_SLOT_BYTES);
+		}
 		if (size > index.capacity()) {
-			// Add some extra space so that we don't need to resize too often
-			index.reserve(NextPowerOfTwo(size));
+			// Add some extra space so that we don't need to resize too often, but no more than we may use
+			const auto growth_limit = MinValue<idx_t>(index.max_size(), MaxValue(size, max_capacity));
+			index.reserve(MinValue(NextPowerOfTwo(size), growth_limit));
 		}
 	}
 
+	// Buffer for the projected vectors, if the index uses a projection
+	unsafe_unique_array<float> projected;
+	if (projection) {
+		projected = make_unsafe_uniq_array<float>(projection->output_dims);
+	}
+
 	{
 		// Now we can be sure that we have enough space in the index
-		auto lock = rwlock.GetSharedLock();
+		auto lock = GetSharedLock();
 		for (idx_t out_idx = 0; out_idx < count; out_idx++) {
 			auto rowid = rowid_data[out_idx];
-			auto result = index.add(rowid, vec_child_data + (out_idx * array_size), thread_idx);
-			if (!result) {
-				throw InternalException("Failed to add to the HNSW index: %s", result.error.what());
+			const float *vec_ptr = vec_child_data + (out_idx * array_size);
+			if (projection) {
+				projection->Project(vec_ptr, projected.get());
+				vec_ptr = projected.get();
+			}
+			auto error = index.add(rowid, vec_ptr, thread_idx);
+			if (error) {
+				throw InternalException("Failed to add to the HNSW index: %s", error.release());
 			}
 		}
 	}
 }
 
-void HNSWIndex::Compact() {
+void HNSWIndex::Compact(ClientContext &context, HNSWCompactionProgress &progress) {
+	if (!mapped_path.empty()) {
+		throw InvalidInputException("Cannot compact HNSW index \"%s\", it is mapped from a read-only database", name);
+	}
+
+	// Acquire an exclusive lock to compact the index
+	auto lock = GetExclusiveLock();
+
+	// Re-compact the index, giving up as soon as the client is interrupted
+	auto error = index.compact([&](size_t processed, size_t total) {
+		progress.processed = processed;
+		progress.total = total;
+		return !context.interrupted.load();
+	});
+	if (error) {
+		auto message = error.release();
+		if (context.interrupted) {
+			throw InterruptException();
+		}
+		throw InternalException("Failed to compact the HNSW index: %s", message);
+	}
+
 	// Mark this index as dirty so we checkpoint it properly
 	is_dirty = true;
 
-	// Acquire an exclusive lock to compact the index
-	auto lock = rwlock.GetExclusiveLock();
-	// Re-compact the index
-	auto result = index.compact();
-	if (!result) {
-		throw InternalException("Failed to compact the HNSW index: %s", result.error.what());
+	index_size = index.size();
+}
+
+void HNSWIndex::Rebuild(ClientContext &context, DataTable &storage, const case_insensitive_map_t<Value> &options) {
+	if (!mapped_path.empty()) {
+		throw InvalidInputException("Cannot rebuild HNSW index \"%s\", it is mapped from a read-only database", name);
 	}
 
+	// Build the new graph in a shadow index, which is not known to the table
+	auto shadow = make_uniq<HNSWIndex>(name, index_constraint_type, column_ids, table_io_manager, unbound_expressions,
+	                                   db, options);
+
+	// The scan reads the indexed columns, followed by the row ids
+	auto table_types = storage.GetTypes();
+	vector<column_t> scan_ids = column_ids;
+	scan_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+	vector<LogicalType> scan_types;
+	for (auto &column_id : column_ids) {
+		scan_types.push_back(table_types[column_id]);
+	}
+	scan_types.push_back(LogicalType::ROW_TYPE);
+
+	vector<LogicalType> data_types = {logical_types[0], LogicalType::ROW_TYPE};
+	ColumnDataCollection collection(BufferManager::GetBufferManager(context), data_types);
+	auto make_log = [&]() {
+		auto log = make_uniq<HNSWRebuildLog>();
+		log->appends = make_uniq<ColumnDataCollection>(BufferManager::GetBufferManager(context), data_types);
+		return log;
+	};
+
+	bool started = false;
+	try {
+		// Collect the vectors of the table while holding its append lock, which commits hold while appending to the
+		// index. Starting the log under it makes sure every row is either collected or logged, and never both.
+		{
+			CreateIndexScanState scan_state;
+			storage.InitializeCreateIndexScan(scan_state, scan_ids);
+			{
+				lock_guard<mutex> guard(rebuild_lock);
+				if (rebuild_log) {
+					throw InvalidInputException("HNSW index \"%s\" is already being rebuilt", name);
+				}
+				rebuild_log = make_log();
+				started = true;
+			}
+
+			DataChunk scan_chunk;
+			scan_chunk.Initialize(Allocator::Get(context), scan_types);
+			// The index expressions refer to the columns by their position in the table
+			DataChunk table_chunk;
+			table_chunk.InitializeEmpty(table_types);
+			DataChunk key_chunk;
+			key_chunk.Initialize(Allocator::Get(context), logical_types);
+			DataChunk data_chunk;
+			data_chunk.InitializeEmpty(data_types);
+
+			while (true) {
+				scan_chunk.Reset();
+				storage.CreateIndexScan(scan_state, scan_chunk,
+				                        TableScanType::TABLE_SCAN_COMMITTED_ROWS_OMIT_PERMANENTLY_DELETED);
+				if (scan_chunk.size() == 0) {
+					break;
+				}
+				for (idx_t i = 0; i < column_ids.size(); i++) {
+					table_chunk.data[column_ids[i]].Reference(scan_chunk.data[i]);
+				}
+				table_chunk.SetCardinality(scan_chunk);
+
+				key_chunk.Reset();
+				shadow->ExecuteExpressions(table_chunk, key_chunk);
+
+				data_chunk.data[0].Reference(key_chunk.data[0]);
+				data_chunk.data[1].Reference(scan_chunk.data[column_ids.size()]);
+				data_chunk.SetCardinality(scan_chunk);
+				collection.Append(data_chunk);
+			}
+		}
+
+		// Build the new graph without holding any lock, appends and deletes are logged in the meantime
+		if (shadow->HasProjection()) {
+			auto sample = HNSWProjection::SampleVectors(collection, HNSWProjection::SAMPLE_SIZE);
+			shadow->LearnProjection(sample.data(), sample.size() / vector_size);
+		}
+		shadow->index.reserve(collection.Count());
+		for (auto &chunk : collection.Chunks()) {
+			if (context.interrupted) {
+				throw InterruptException();
+			}
+			shadow->Construct(chunk, chunk.data[1], unum::usearch::index_dense_t::any_thread());
+		}
+		collection.Reset();
+
+		// Catch up on the changes logged during the build, again without blocking searches
+		unique_ptr<HNSWRebuildLog> log;
+		{
+			lock_guard<mutex> guard(rebuild_lock);
+			log = std::move(rebuild_log);
+			rebuild_log = make_log();
+		}
+		shadow->ApplyRebuildLog(*log);
+		log.reset();
+	} catch (...) {
+		if (started) {
+			lock_guard<mutex> guard(rebuild_lock);
+			rebuild_log.reset();
+		}
+		throw;
+	}
+
+	// Apply the changes logged during the catch up, and swap in the new graph. Appends and deletes wait for the swap,
+	// searches only for the last changes.
+	lock_guard<mutex> guard(rebuild_lock);
+	auto lock = GetExclusiveLock();
+	shadow->ApplyRebuildLog(*rebuild_log);
+	rebuild_log.reset();
+
+	std::swap(index, shadow->index);
+	std::swap(projection, shadow->projection);
+	refine_metric = shadow->refine_metric;
+	requires_refinement = shadow->requires_refinement;
+	learn_projection = shadow->learn_projection;
+	compress_neighbors = shadow->compress_neighbors;
+	simd_capabilities = shadow->simd_capabilities.load();
+
+	// Mark this index as dirty so we checkpoint it properly
+	is_dirty = true;
+
+	index_size = index.size();
+}
+
+void HNSWIndex::ApplyRebuildLog(HNSWRebuildLog &log) {
+	for (auto &chunk : log.appends->Chunks()) {
+		Construct(chunk, chunk.data[1], unum::usearch::index_dense_t::any_thread());
+	}
+	auto lock = GetExclusiveLock();
+	for (auto &row_id : log.deletes) {
+		index.remove(row_id);
+	}
 	index_size = index.size();
 }
 
+idx_t HNSWIndex::Warmup(idx_t queries) {
+	auto lock = GetSharedLock();
+	warmups++;
+	return index.warmup(queries);
+}
+
 void HNSWIndex::Delete(IndexLock &lock, DataChunk &input, Vector &rowid_vec) {
 	// Mark this index as dirty so we checkpoint it properly
 	is_dirty = true;
@@ -429,8 +1392,14 @@ void HNSWIndex::Delete(IndexLock &lock, DataChunk &input, Vector &rowid_vec) {
 	rowid_vec.Flatten(count);
 	auto row_id_data = FlatVector::GetData<row_t>(rowid_vec);
 
+	// A running rebuild has to catch up on the deleted rows as well
+	lock_guard<mutex> guard(rebuild_lock);
+	if (rebuild_log) {
+		rebuild_log->deletes.insert(rebuild_log->deletes.end(), row_id_data, row_id_data + count);
+	}
+
 	// For deleting from the index, we need an exclusive lock
-	auto _lock = rwlock.GetExclusiveLock();
+	auto _lock = GetExclusiveLock();
 
 	for (idx_t i = 0; i < input.size(); i++) {
 		auto result = index.remove(row_id_data[i]);
@@ -440,6 +1409,17 @@ void HNSWIndex::Delete(IndexLock &lock, DataChunk &input, Vector &rowid_vec) {
 }
 
 ErrorData HNSWIndex::Insert(IndexLock &lock, DataChunk &input, Vector &rowid_vec) {
+	// A running rebuild has to catch up on the inserted rows as well
+	lock_guard<mutex> guard(rebuild_lock);
+	if (rebuild_log) {
+		DataChunk log_chunk;
+		log_chunk.InitializeEmpty(rebuild_log->appends->Types());
+		log_chunk.data[0].Reference(input.data[0]);
+		log_chunk.data[1].Reference(rowid_vec);
+		log_chunk.SetCardinality(input);
+		rebuild_log->appends->Append(log_chunk);
+	}
+
 	Construct(input, rowid_vec, unum::usearch::index_dense_t::any_thread());
 	return ErrorData {};
 }
@@ -452,9 +1432,7 @@ ErrorData HNSWIndex::Append(IndexLock &lock, DataChunk &appended_data, Vector &r
 	ExecuteExpressions(appended_data, expression_result);
 
 	// now insert into the index
-	Construct(expression_result, row_identifiers, unum::usearch::index_dense_t::any_thread());
-
-	return ErrorData {};
+	return Insert(lock, expression_result, row_identifiers);
 }
 
 void HNSWIndex::VerifyAppend(DataChunk &chunk) {
@@ -467,7 +1445,7 @@ void HNSWIndex::VerifyAppend(DataChunk &chunk, ConflictManager &conflict_manager
 
 void HNSWIndex::PersistToDisk() {
 	// Acquire an exclusive lock to persist the index
-	auto lock = rwlock.GetExclusiveLock();
+	auto lock = GetExclusiveLock();
 
 	// If there haven't been any changes, we don't need to rewrite the index again
 	if (!is_dirty) {
@@ -482,10 +1460,19 @@ void HNSWIndex::PersistToDisk() {
 
 	LinkedBlockWriter writer(*linked_block_allocator, root_block_ptr);
 	writer.Reset();
-	index.save_to_stream([&](const void *data, size_t size) {
-		writer.WriteData(static_cast<const_data_ptr_t>(data), size);
-		return true;
-	});
+	unum::usearch::index_dense_serialization_config_t config;
+	config.compress_neighbors = compress_neighbors;
+	index.save_to_stream(
+	    [&](const void *data, size_t size) {
+		    writer.WriteData(static_cast<const_data_ptr_t>(data), size);
+		    return true;
+	    },
+	    config);
+
+	// The projection is stored right after the graph
+	if (projection) {
+		writer.WriteData(reinterpret_cast<const_data_ptr_t>(projection->matrix.data()), projection->GetSizeInBytes());
+	}
 
 	is_dirty = false;
 }
@@ -514,7 +1501,37 @@ IndexStorageInfo HNSWIndex::GetStorageInfo(const bool get_buffers) {
 
 idx_t HNSWIndex::GetInMemorySize(IndexLock &state) {
 	// TODO: This is not correct: its a lower bound, but it's a start
-	return index.memory_usage();
+	return index.memory_usage() + (projection ? projection->GetSizeInBytes() : 0);
+}
+
+// The estimated memory used by every vector of the graph
+static idx_t EstimateNodeMemoryUsage(const HNSWGraph &index) {
+	const auto slot_bytes = index.slot_bytes();
+	const auto &config = index.config();
+
+	// Every node stores its key, level and base level neighbours, and a node reaches the upper levels with a
+	// probability of 1 / M per level, so on average it has 1 / (M - 1) lists of upper level neighbours as well
+	const auto base_bytes = sizeof(row_t) + sizeof(int16_t) + sizeof(uint32_t) + config.connectivity_base * slot_bytes;
+	const auto upper_bytes =
+	    (sizeof(uint32_t) + config.connectivity * slot_bytes) / MaxValue<idx_t>(1, config.connectivity - 1);
+
+	// The lookups from slots to nodes and vectors, and from keys to slots, and the padding of the allocators
+	const auto lookup_bytes = 2 * sizeof(void *) + 2 * (sizeof(row_t) + slot_bytes);
+	const idx_t padding_bytes = 64;
+
+	return base_bytes + upper_bytes + index.bytes_per_vector() + lookup_bytes + padding_bytes;
+}
+
+idx_t HNSWIndex::EstimateMemoryUsage(idx_t count) const {
+	return count * EstimateNodeMemoryUsage(index) + (projection ? projection->GetSizeInBytes() : 0);
+}
+
+idx_t HNSWIndex::EstimateCapacity(idx_t memory) const {
+	const auto projection_bytes = projection ? projection->GetSizeInBytes() : 0;
+	if (memory <= projection_bytes) {
+		return 0;
+	}
+	return (memory - projection_bytes) / EstimateNodeMemoryUsage(index);
 }
 
 bool HNSWIndex::MergeIndexes(IndexLock &state, BoundIndex &other_index) {
@@ -532,9 +1549,63 @@ string HNSWIndex::VerifyAndToString(IndexLock &state, const bool only_verify) {
 	throw NotImplementedException("HNSWIndex::VerifyAndToString() not implemented");
 }
 
+//------------------------------------------------------------------------------
+// Lookup
+//------------------------------------------------------------------------------
+HNSWIndexLookup LookupHNSWIndex(ClientContext &context, const string &index_name) {
+	auto qname = QualifiedName::Parse(index_name);
+
+	// look up the index name in the catalog
+	Binder::BindSchemaOrCatalog(context, qname.catalog, qname.schema);
+	auto &index_entry = Catalog::GetEntry(context, CatalogType::INDEX_ENTRY, qname.catalog, qname.schema, qname.name)
+	                        .Cast<IndexCatalogEntry>();
+	if (index_entry.index_type != HNSWIndex::TYPE_NAME) {
+		throw InvalidInputException("Index '%s' is not an HNSW index", index_name);
+	}
+	auto &table_entry = index_entry.schema.catalog
+	                        .GetEntry(context, CatalogType::TABLE_ENTRY, index_entry.GetSchemaName(),
+	                                  index_entry.GetTableName())
+	                        .Cast<DuckTableEntry>();
+
+	// Find the index in the storage of the table
+	optional_ptr<HNSWIndex> index;
+	auto &table_info = *table_entry.GetStorage().GetDataTableInfo();
+	table_info.GetIndexes().BindAndScan<HNSWIndex>(context, table_info, [&](HNSWIndex &hnsw_index) {
+		if (hnsw_index.name != index_entry.name) {
+			return false;
+		}
+		index = &hnsw_index;
+		return true;
+	});
+	if (!index) {
+		throw BinderException("Index %s not found", index_name);
+	}
+	return HNSWIndexLookup {index_entry, table_entry, *index};
+}
+
 //------------------------------------------------------------------------------
 // Register Index Type
 //------------------------------------------------------------------------------
+// Set an option that is read when indexes are loaded, which happens for the whole database rather than for the client
+// that set it
+static void SetDatabaseOption(ClientContext &context, SetScope scope, const char *name, const Value &parameter) {
+	if (scope == SetScope::LOCAL || scope == SetScope::SESSION) {
+		throw InvalidInputException("%s applies to the whole database, use SET GLOBAL %s instead", name, name);
+	}
+	// A plain SET only changes the setting of the client, so change the one of the database as well
+	if (scope == SetScope::AUTOMATIC) {
+		DBConfig::GetConfig(context).SetOption(name, parameter);
+	}
+}
+
+static void SetWarmupOnLoad(ClientContext &context, SetScope scope, Value &parameter) {
+	SetDatabaseOption(context, scope, HNSWIndex::WARMUP_ON_LOAD_SETTING, parameter);
+}
+
+static void SetMmapDirectory(ClientContext &context, SetScope scope, Value &parameter) {
+	SetDatabaseOption(context, scope, HNSWIndex::MMAP_DIRECTORY_SETTING, parameter);
+}
+
 void HNSWModule::RegisterIndex(DatabaseInstance &db) {
 
 	IndexType index_type;
@@ -550,6 +1621,19 @@ void HNSWModule::RegisterIndex(DatabaseInstance &db) {
 	db.config.AddExtensionOption("hnsw_ef_search",
 	                             "experimental: override the ef_search parameter when scanning HNSW indexes",
 	                             LogicalType::BIGINT);
+	db.config.AddExtensionOption("hnsw_refine_factor",
+	                             "experimental: the number of candidates to fetch per result row when refining scans "
+	                             "of HNSW indexes built with 'search_dims'",
+	                             LogicalType::BIGINT);
+
+	db.config.AddExtensionOption(WARMUP_ON_LOAD_SETTING,
+	                             "warm up HNSW indexes as soon as they are loaded from disk, like hnsw_warmup does",
+	                             LogicalType::BOOLEAN, Value::BOOLEAN(false), SetWarmupOnLoad);
+
+	db.config.AddExtensionOption(MMAP_DIRECTORY_SETTING,
+	                             "directory to share memory-mapped copies of the HNSW indexes of read-only databases "
+	                             "between processes in, instead of loading a copy into every process",
+	                             LogicalType::VARCHAR, Value(""), SetMmapDirectory);
 
 	// Register the index type
 	db.config.GetIndexTypes().RegisterIndexType(index_type);
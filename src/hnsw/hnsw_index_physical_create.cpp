@@ -3,11 +3,15 @@
 #include "duckdb/catalog/catalog_entry/duck_index_entry.hpp"
 #include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/algorithm.hpp"
 #include "duckdb/common/exception/transaction_exception.hpp"
+#include "duckdb/common/random_engine.hpp"
 #include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/config.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/table_io_manager.hpp"
+#include "hnsw/hnsw_build_order.hpp"
 #include "hnsw/hnsw_index.hpp"
 
 #include "duckdb/parallel/base_pipeline_event.hpp"
@@ -41,21 +45,193 @@ public:
 	unique_ptr<ColumnDataCollection> collection;
 	shared_ptr<ClientContext> context;
 
+	// The options of the new index, which start out as the ones of the statement. They are changed here rather than
+	// in the statement, which may be executed again.
+	case_insensitive_map_t<Value> options;
+
 	// Parallel scan state
 	ColumnDataParallelScanState scan_state;
 
+	// The vectors and row ids when they are not inserted in scan order, and the order to insert them in
+	unsafe_unique_array<float> build_vectors;
+	unsafe_unique_array<row_t> build_row_ids;
+	vector<idx_t> build_order;
+	atomic<idx_t> next_build_offset = {0};
+
+	// For hierarchical builds, the levels of the first vectors of the build order, which make up the upper levels
+	// of the graph and are inserted first. The remaining vectors are inserted into the base level only.
+	bool hierarchical_build = false;
+	vector<int32_t> upper_levels;
+
+	// The part of the build order inserted by the current phase, and the number of vectors claimed at once
+	idx_t phase_end = 0;
+	idx_t batch_size = STANDARD_VECTOR_SIZE;
+
+	void StartBuildPhase(idx_t start, idx_t end, idx_t threads) {
+		next_build_offset = start;
+		phase_end = end;
+		// Hand out enough batches to keep all threads busy, the upper levels can be quite small
+		batch_size = MaxValue<idx_t>(1, MinValue<idx_t>(STANDARD_VECTOR_SIZE, (end - start) / (threads * 8)));
+	}
+
+	// The memory budget of the build, and whether the vectors are inserted into the graph as they arrive instead of
+	// being collected first to stay within it
+	idx_t max_build_memory = DConstants::INVALID_INDEX;
+	bool streaming = false;
+	// The number of vectors the graph can hold within the budget, which it is not grown beyond while streaming
+	idx_t max_capacity = DConstants::INVALID_INDEX;
+
+	// Whether the width of the slots of the graph was picked by us, and can still be changed
+	bool pick_slot_bytes = false;
+
+	// The file the graph was imported from instead of being built, and the sorted row ids of its vectors, which
+	// have to match the rows of the table
+	string import_path;
+	vector<row_t> import_row_ids;
+
+	// The index the graph was copied from instead of being built, and the row ids of the table, which the row ids of
+	// the copied graph are mapped to in order
+	string source_index_name;
+	vector<row_t> copy_row_ids;
+	// A sample of the rows of the table and their vectors, which have to match the vectors of the copied graph they
+	// are mapped to
+	vector<row_t> copy_sample_row_ids;
+	vector<float> copy_sample_vectors;
+
 	// Track which phase we're in
 	atomic<bool> is_building = {false};
 	atomic<idx_t> loaded_count = {0};
 	atomic<idx_t> built_count = {0};
 };
 
+static idx_t GetMaxBuildMemory(const case_insensitive_map_t<Value> &options) {
+	auto max_build_memory_opt = options.find("max_build_memory");
+	if (max_build_memory_opt == options.end()) {
+		return DConstants::INVALID_INDEX;
+	}
+	return DBConfig::ParseMemoryLimit(max_build_memory_opt->second.GetValue<string>());
+}
+
+// Whether all vectors have to be collected before the graph can be built, to learn a projection from or to pick the
+// order to insert them in
+static bool NeedsAllVectors(const case_insensitive_map_t<Value> &options, const HNSWIndex &index) {
+	if (index.HasProjection()) {
+		return true;
+	}
+	auto build_order_opt = options.find("build_order");
+	if (build_order_opt != options.end() &&
+	    !StringUtil::CIEquals(build_order_opt->second.GetValue<string>(), HNSWBuildOrder::SCAN)) {
+		return true;
+	}
+	auto hierarchical_opt = options.find("hierarchical_build");
+	return hierarchical_opt != options.end() && hierarchical_opt->second.GetValue<bool>();
+}
+
+// Throw if the graph of "count" vectors would not fit into the memory budget of the build
+static void CheckBuildMemory(const CreateHNSWIndexGlobalState &gstate, idx_t count) {
+	if (gstate.max_build_memory == DConstants::INVALID_INDEX) {
+		return;
+	}
+	const auto graph_bytes = gstate.global_index->EstimateMemoryUsage(count);
+	if (graph_bytes > gstate.max_build_memory) {
+		throw OutOfMemoryException(
+		    "The HNSW index of %llu vectors needs about %s, which exceeds its max_build_memory of %s", count,
+		    StringUtil::BytesToHumanReadableString(graph_bytes),
+		    StringUtil::BytesToHumanReadableString(gstate.max_build_memory));
+	}
+}
+
+// Throw if one of the vectors or row ids of the chunk is NULL, the graph cannot hold them
+static void CheckNotNull(DataChunk &chunk) {
+	for (auto &vec : chunk.data) {
+		UnifiedVectorFormat format;
+		vec.ToUnifiedFormat(chunk.size(), format);
+		for (idx_t i = 0; i < chunk.size(); i++) {
+			if (!format.validity.RowIsValid(format.sel->get_index(i))) {
+				throw InvalidInputException(
+				    "Invalid data in HNSW index construction: Cannot construct index with NULL values.");
+			}
+		}
+	}
+}
+
+// Throw if the imported graph has no vector for one of the rows, or another one than the row holds. Row ids are
+// positions in the table, so the table has to hold the same rows in the same order as the table the graph was
+// exported from.
+static void CheckImportedRows(const CreateHNSWIndexGlobalState &gstate, DataChunk &chunk) {
+	CheckNotNull(chunk);
+	chunk.Flatten();
+	const auto count = chunk.size();
+	const auto row_ptr = FlatVector::GetData<row_t>(chunk.data[1]);
+	for (idx_t i = 0; i < count; i++) {
+		const auto row_id = row_ptr[i];
+		if (!std::binary_search(gstate.import_row_ids.begin(), gstate.import_row_ids.end(), row_id)) {
+			throw InvalidInputException("The HNSW index in '%s' has no vector for row %lld of the table, it was "
+			                            "exported from a table with other rows",
+			                            gstate.import_path, row_id);
+		}
+	}
+	const auto vec_ptr = FlatVector::GetData<float>(ArrayVector::GetEntry(chunk.data[0]));
+	auto mismatch = gstate.global_index->FindMismatchedVector(vec_ptr, row_ptr, count);
+	if (mismatch.IsValid()) {
+		throw InvalidInputException("The HNSW index in '%s' has another vector for row %lld of the table, it was "
+		                            "exported from a table with other rows or rows in another order",
+		                            gstate.import_path, row_ptr[mismatch.GetIndex()]);
+	}
+}
+
+// One in this many rows of a table is checked against the graph it copies the vectors of
+static constexpr const idx_t COPY_CHECK_INTERVAL = 256;
+
 unique_ptr<GlobalSinkState> PhysicalCreateHNSWIndex::GetGlobalSinkState(ClientContext &context) const {
 	auto gstate = make_uniq<CreateHNSWIndexGlobalState>();
 
 	vector<LogicalType> data_types = {unbound_expressions[0]->return_type, LogicalType::ROW_TYPE};
 	gstate->collection = make_uniq<ColumnDataCollection>(BufferManager::GetBufferManager(context), data_types);
 	gstate->context = context.shared_from_this();
+	gstate->options = info->options;
+	auto &options = gstate->options;
+
+	// Import the graph from a file rather than building it, if requested
+	auto from_file_opt = options.find("from_file");
+	if (from_file_opt != options.end()) {
+		gstate->import_path = from_file_opt->second.GetValue<string>();
+	}
+
+	// Or copy the graph of another index, which may be in another attached database, taking over the options it was
+	// built with
+	optional_ptr<HNSWIndex> source_index;
+	auto from_index_opt = options.find("from_index");
+	if (from_index_opt != options.end()) {
+		gstate->source_index_name = from_index_opt->second.GetValue<string>();
+		auto source = LookupHNSWIndex(context, gstate->source_index_name);
+		source_index = &source.index;
+		options = source.index.GetEntryOptions(source.index_entry);
+		auto &key_expr = *unbound_expressions[0];
+		HNSWIndex::VerifyOptions(options, key_expr.return_type,
+		                         key_expr.type == ExpressionType::BOUND_COLUMN_REF);
+		// Indexes created before the width of the slots was stored have narrow slots
+		if (options.find("slot_bytes") == options.end()) {
+			options["slot_bytes"] = Value::INTEGER(static_cast<int32_t>(HNSWGraph::NARROW_SLOT_BYTES));
+		}
+	}
+
+	// Pick the width of the slots of the graph from the expected row count, unless it was given. The chosen width is
+	// stored with the index, so that the graph can be loaded again. Imported graphs keep the width they were saved with.
+	if (!gstate->import_path.empty()) {
+		const auto slot_bytes = HNSWIndex::ReadFileSlotBytes(context, gstate->import_path);
+		auto slot_bytes_opt = options.find("slot_bytes");
+		if (slot_bytes_opt != options.end() && slot_bytes_opt->second.GetValue<int32_t>() != slot_bytes) {
+			throw InvalidInputException("The HNSW index in '%s' has %llu bytes per slot, but slot_bytes is %d",
+			                            gstate->import_path, slot_bytes, slot_bytes_opt->second.GetValue<int32_t>());
+		}
+		options["slot_bytes"] = Value::INTEGER(static_cast<int32_t>(slot_bytes));
+	} else if (options.find("slot_bytes") == options.end()) {
+		const auto wide = estimated_cardinality > HNSWGraph::MAX_NARROW_SIZE;
+		const auto slot_bytes = wide ? HNSWGraph::WIDE_SLOT_BYTES : HNSWGraph::NARROW_SLOT_BYTES;
+		options["slot_bytes"] = Value::INTEGER(static_cast<int32_t>(slot_bytes));
+		gstate->pick_slot_bytes = true;
+	}
 
 	// Create the index
 	auto &storage = table.GetStorage();
@@ -64,7 +240,38 @@ unique_ptr<GlobalSinkState> PhysicalCreateHNSWIndex::GetGlobalSinkState(ClientCo
 	auto &db = storage.db;
 	gstate->global_index =
 	    make_uniq<HNSWIndex>(info->index_name, constraint_type, storage_ids, table_manager, unbound_expressions, db,
-	                         info->options, IndexStorageInfo(), estimated_cardinality);
+	                         options, IndexStorageInfo(), estimated_cardinality);
+
+	if (!gstate->import_path.empty()) {
+		gstate->global_index->Import(context, gstate->import_path);
+		gstate->import_row_ids = gstate->global_index->index.keys();
+		std::sort(gstate->import_row_ids.begin(), gstate->import_row_ids.end());
+		return std::move(gstate);
+	}
+
+	if (source_index) {
+		if (source_index->logical_types[0] != gstate->global_index->logical_types[0]) {
+			throw InvalidInputException("HNSW index '%s' is over vectors of type %s, but the new index is over %s",
+			                            gstate->source_index_name, source_index->logical_types[0].ToString(),
+			                            gstate->global_index->logical_types[0].ToString());
+		}
+		gstate->global_index->CopyFrom(*source_index);
+		gstate->import_row_ids = gstate->global_index->index.keys();
+		std::sort(gstate->import_row_ids.begin(), gstate->import_row_ids.end());
+		return std::move(gstate);
+	}
+
+	// Skip collecting the vectors if they would not fit into the memory budget together with the graph
+	gstate->max_build_memory = GetMaxBuildMemory(options);
+	if (gstate->max_build_memory != DConstants::INVALID_INDEX && !NeedsAllVectors(options, *gstate->global_index)) {
+		const auto array_size = ArrayType::GetSize(unbound_expressions[0]->return_type);
+		const auto data_bytes = estimated_cardinality * (array_size * sizeof(float) + sizeof(row_t));
+		const auto graph_bytes = gstate->global_index->EstimateMemoryUsage(estimated_cardinality);
+		gstate->streaming = data_bytes + graph_bytes > gstate->max_build_memory;
+		if (gstate->streaming) {
+			gstate->max_capacity = gstate->global_index->EstimateCapacity(gstate->max_build_memory);
+		}
+	}
 
 	return std::move(gstate);
 }
@@ -76,6 +283,11 @@ class CreateHNSWIndexLocalState final : public LocalSinkState {
 public:
 	unique_ptr<ColumnDataCollection> collection;
 	ColumnDataAppendState append_state;
+	//! The row ids of the table, when the graph is copied from another index
+	vector<row_t> copy_row_ids;
+	//! A sample of the rows of the table and their vectors, when the graph is copied from another index
+	vector<row_t> copy_sample_row_ids;
+	vector<float> copy_sample_vectors;
 };
 
 unique_ptr<LocalSinkState> PhysicalCreateHNSWIndex::GetLocalSinkState(ExecutionContext &context) const {
@@ -96,6 +308,45 @@ SinkResultType PhysicalCreateHNSWIndex::Sink(ExecutionContext &context, DataChun
 
 	auto &lstate = input.local_state.Cast<CreateHNSWIndexLocalState>();
 	auto &gstate = input.global_state.Cast<CreateHNSWIndexGlobalState>();
+
+	if (!gstate.import_path.empty()) {
+		// The vectors are already in the imported graph, only check that it has the one of every row
+		CheckImportedRows(gstate, chunk);
+		gstate.loaded_count += chunk.size();
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+
+	if (!gstate.source_index_name.empty()) {
+		// The vectors are already in the copied graph, only collect the row ids to map its vectors to, and a sample
+		// of the vectors to check the mapping with
+		CheckNotNull(chunk);
+		chunk.Flatten();
+		const auto row_ptr = FlatVector::GetData<row_t>(chunk.data[1]);
+		const auto vec_ptr = FlatVector::GetData<float>(ArrayVector::GetEntry(chunk.data[0]));
+		const auto array_size = ArrayType::GetSize(chunk.data[0].GetType());
+		for (idx_t i = 0; i < chunk.size(); i++) {
+			lstate.copy_row_ids.push_back(row_ptr[i]);
+			if (i % COPY_CHECK_INTERVAL == 0) {
+				lstate.copy_sample_row_ids.push_back(row_ptr[i]);
+				lstate.copy_sample_vectors.insert(lstate.copy_sample_vectors.end(), vec_ptr + i * array_size,
+				                                  vec_ptr + (i + 1) * array_size);
+			}
+		}
+		gstate.loaded_count += chunk.size();
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+
+	if (gstate.streaming) {
+		// Insert the vectors right away, the graph grows as needed but not beyond the budget
+		CheckNotNull(chunk);
+		const auto count = gstate.loaded_count.fetch_add(chunk.size()) + chunk.size();
+		CheckBuildMemory(gstate, count);
+		gstate.global_index->Construct(chunk, chunk.data[1], unum::usearch::index_dense_t::any_thread(),
+		                               gstate.max_capacity);
+		gstate.built_count += chunk.size();
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+
 	lstate.collection->Append(lstate.append_state, chunk);
 	gstate.loaded_count += chunk.size();
 	return SinkResultType::NEED_MORE_INPUT;
@@ -109,6 +360,15 @@ SinkCombineResultType PhysicalCreateHNSWIndex::Combine(ExecutionContext &context
 	auto &gstate = input.global_state.Cast<CreateHNSWIndexGlobalState>();
 	auto &lstate = input.local_state.Cast<CreateHNSWIndexLocalState>();
 
+	if (!lstate.copy_row_ids.empty()) {
+		lock_guard<mutex> l(gstate.glock);
+		gstate.copy_row_ids.insert(gstate.copy_row_ids.end(), lstate.copy_row_ids.begin(), lstate.copy_row_ids.end());
+		gstate.copy_sample_row_ids.insert(gstate.copy_sample_row_ids.end(), lstate.copy_sample_row_ids.begin(),
+		                                  lstate.copy_sample_row_ids.end());
+		gstate.copy_sample_vectors.insert(gstate.copy_sample_vectors.end(), lstate.copy_sample_vectors.begin(),
+		                                  lstate.copy_sample_vectors.end());
+	}
+
 	if (lstate.collection->Count() == 0) {
 		return SinkCombineResultType::FINISHED;
 	}
@@ -134,11 +394,59 @@ public:
 	    : ExecutorTask(context, std::move(event_p)), gstate(gstate_p), thread_id(thread_id_p), local_scan_state() {
 		// Initialize the scan chunk
 		gstate.collection->InitializeScanChunk(scan_chunk);
+
+		// Initialize the buffer for projected vectors
+		if (gstate.global_index->HasProjection()) {
+			projected = make_unsafe_uniq_array<float>(gstate.global_index->GetSearchDimensions());
+		}
 	}
 
 	TaskExecutionResult ExecuteTask(TaskExecutionMode mode) override {
+		if (!gstate.build_vectors) {
+			return InsertInScanOrder(mode);
+		}
 
-		auto &index = gstate.global_index->index;
+		const auto array_size = gstate.global_index->GetVectorSize();
+		while (true) {
+			// Tasks running in PROCESS_ALL mode never return to the executor, so check for interrupts ourselves
+			if (gstate.context->interrupted) {
+				throw InterruptException();
+			}
+
+			// Claim the next batch of the current phase
+			const auto start = gstate.next_build_offset.fetch_add(gstate.batch_size);
+			if (start >= gstate.phase_end) {
+				break;
+			}
+			const auto end = MinValue<idx_t>(start + gstate.batch_size, gstate.phase_end);
+			for (idx_t i = start; i < end; i++) {
+				const auto idx = gstate.build_order[i];
+				// Use the drawn level for the upper levels, and only insert the rest into the base level
+				int32_t level = -1;
+				if (gstate.hierarchical_build) {
+					level = i < gstate.upper_levels.size() ? gstate.upper_levels[i] : 0;
+				}
+				if (!AddVector(gstate.build_vectors.get() + idx * array_size, gstate.build_row_ids[idx], level)) {
+					return TaskExecutionResult::TASK_ERROR;
+				}
+			}
+
+			// Update the built count
+			gstate.built_count += end - start;
+
+			if (mode == TaskExecutionMode::PROCESS_PARTIAL) {
+				// yield!
+				return TaskExecutionResult::TASK_NOT_FINISHED;
+			}
+		}
+
+		// Finish task!
+		event->FinishTask();
+		return TaskExecutionResult::TASK_FINISHED;
+	}
+
+private:
+	TaskExecutionResult InsertInScanOrder(TaskExecutionMode mode) {
 		auto &scan_state = gstate.scan_state;
 		auto &collection = gstate.collection;
 
@@ -146,6 +454,11 @@ public:
 
 		while (collection->Scan(scan_state, local_scan_state, scan_chunk)) {
 
+			// Tasks running in PROCESS_ALL mode never return to the executor, so check for interrupts ourselves
+			if (gstate.context->interrupted) {
+				throw InterruptException();
+			}
+
 			const auto count = scan_chunk.size();
 			auto &vec_vec = scan_chunk.data[0];
 			auto &data_vec = ArrayVector::GetEntry(vec_vec);
@@ -175,12 +488,7 @@ public:
 					return TaskExecutionResult::TASK_ERROR;
 				}
 
-				// Add the vector to the index
-				const auto result = index.add(row_ptr[row_idx], data_ptr + (vec_idx * array_size), thread_id);
-
-				// Check for errors
-				if (!result) {
-					executor.PushError(ErrorData(result.error.what()));
+				if (!AddVector(data_ptr + (vec_idx * array_size), row_ptr[row_idx])) {
 					return TaskExecutionResult::TASK_ERROR;
 				}
 			}
@@ -199,12 +507,32 @@ public:
 		return TaskExecutionResult::TASK_FINISHED;
 	}
 
-private:
+	bool AddVector(const float *vec_ptr, row_t row_id, int32_t level = -1) {
+		// Project the vector into the space of the graph, if needed
+		if (projected) {
+			gstate.global_index->ProjectVector(vec_ptr, projected.get());
+			vec_ptr = projected.get();
+		}
+
+		// Add the vector to the index
+		auto error = gstate.global_index->index.add(row_id, vec_ptr, thread_id, true, level);
+
+		// Check for errors
+		if (error) {
+			executor.PushError(ErrorData(error.release()));
+			return false;
+		}
+		return true;
+	}
+
 	CreateHNSWIndexGlobalState &gstate;
 	size_t thread_id;
 
 	DataChunk scan_chunk;
 	ColumnDataLocalScanState local_scan_state;
+
+	//! Buffer for the projected vector
+	unsafe_unique_array<float> projected;
 };
 
 class HNSWIndexConstructionEvent final : public BasePipelineEvent {
@@ -221,6 +549,12 @@ public:
 
 public:
 	void Schedule() override {
+		// Without tasks the event finishes right away, which only registers the index. This is the case if the graph
+		// is complete already, because it was imported, copied, or built while sinking.
+		if (gstate.built_count == gstate.loaded_count) {
+			return;
+		}
+
 		auto &context = pipeline->GetClientContext();
 
 		// Schedule tasks equal to the number of threads, which will construct the index
@@ -236,6 +570,15 @@ public:
 
 	void FinishEvent() override {
 
+		// Insert the base level once the upper levels of a hierarchical build are done
+		if (gstate.phase_end < gstate.build_order.size()) {
+			auto &ts = TaskScheduler::GetScheduler(pipeline->GetClientContext());
+			gstate.StartBuildPhase(gstate.phase_end, gstate.build_order.size(),
+			                       NumericCast<idx_t>(ts.NumberOfThreads()));
+			InsertEvent(make_shared_ptr<HNSWIndexConstructionEvent>(gstate, *pipeline, info, storage_ids, table));
+			return;
+		}
+
 		// Mark the index as dirty, update its count
 		gstate.global_index->SetDirty();
 		gstate.global_index->SyncSize();
@@ -252,12 +595,16 @@ public:
 			throw TransactionException("Cannot create index on non-root transaction");
 		}
 
-		// Create the index entry in the catalog
+		// Create the index entry in the catalog, with the options the index was built with. The file a graph was
+		// imported from is not kept, as the index does not depend on it once imported.
+		auto entry_info = unique_ptr_cast<CreateInfo, CreateIndexInfo>(info.Copy());
+		entry_info->options = gstate.options;
+		entry_info->options.erase("from_file");
+		entry_info->column_ids = storage_ids;
 		auto &schema = table.schema;
-		info.column_ids = storage_ids;
-		const auto index_entry = schema.CreateIndex(*gstate.context, info, table).get();
+		const auto index_entry = schema.CreateIndex(*gstate.context, *entry_info, table).get();
 		if (!index_entry) {
-			D_ASSERT(info.on_conflict == OnCreateConflict::IGNORE_ON_CONFLICT);
+			D_ASSERT(entry_info->on_conflict == OnCreateConflict::IGNORE_ON_CONFLICT);
 			// index already exists, but error ignored because of IF NOT EXISTS
 			// return SinkFinalizeType::READY;
 			return;
@@ -267,7 +614,7 @@ public:
 		auto &duck_index = index_entry->Cast<DuckIndexEntry>();
 		duck_index.initial_index_size = gstate.global_index->Cast<BoundIndex>().GetInMemorySize();
 		duck_index.info = make_uniq<IndexDataTableInfo>(storage.GetDataTableInfo(), duck_index.name);
-		for (auto &parsed_expr : info.parsed_expressions) {
+		for (auto &parsed_expr : entry_info->parsed_expressions) {
 			duck_index.parsed_expressions.push_back(parsed_expr->Copy());
 		}
 
@@ -276,6 +623,49 @@ public:
 	}
 };
 
+// Copy the collected vectors and row ids into flat arrays, so that they can be inserted in any order
+static void MaterializeVectors(CreateHNSWIndexGlobalState &gstate) {
+	auto &collection = *gstate.collection;
+	const auto array_size = ArrayType::GetSize(collection.Types()[0]);
+	const auto count = collection.Count();
+	gstate.build_vectors = make_unsafe_uniq_array<float>(count * array_size);
+	gstate.build_row_ids = make_unsafe_uniq_array<row_t>(count);
+
+	idx_t offset = 0;
+	for (auto &chunk : collection.Chunks()) {
+		const auto chunk_size = chunk.size();
+		auto &vec_vec = chunk.data[0];
+		auto &data_vec = ArrayVector::GetEntry(vec_vec);
+		auto &rowid_vec = chunk.data[1];
+
+		UnifiedVectorFormat vec_format;
+		UnifiedVectorFormat data_format;
+		UnifiedVectorFormat rowid_format;
+		vec_vec.ToUnifiedFormat(chunk_size, vec_format);
+		data_vec.ToUnifiedFormat(chunk_size * array_size, data_format);
+		rowid_vec.ToUnifiedFormat(chunk_size, rowid_format);
+
+		const auto row_ptr = UnifiedVectorFormat::GetData<row_t>(rowid_format);
+		const auto data_ptr = UnifiedVectorFormat::GetData<float>(data_format);
+
+		for (idx_t i = 0; i < chunk_size; i++) {
+			const auto vec_idx = vec_format.sel->get_index(i);
+			const auto row_idx = rowid_format.sel->get_index(i);
+			if (!vec_format.validity.RowIsValid(vec_idx) || !rowid_format.validity.RowIsValid(row_idx)) {
+				throw InvalidInputException(
+				    "Invalid data in HNSW index construction: Cannot construct index with NULL values.");
+			}
+			memcpy(gstate.build_vectors.get() + offset * array_size, data_ptr + vec_idx * array_size,
+			       array_size * sizeof(float));
+			gstate.build_row_ids[offset] = row_ptr[row_idx];
+			offset++;
+		}
+	}
+
+	// The collection is no longer needed, release its memory before building the graph
+	collection.Reset();
+}
+
 SinkFinalizeType PhysicalCreateHNSWIndex::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
                                                    OperatorSinkFinalizeInput &input) const {
 
@@ -286,13 +676,133 @@ SinkFinalizeType PhysicalCreateHNSWIndex::Finalize(Pipeline &pipeline, Event &ev
 	// Move on to the next phase
 	gstate.is_building = true;
 
+	if (!gstate.import_path.empty()) {
+		// Every row has a vector in the imported graph, so it has no others if the counts match
+		if (gstate.loaded_count != gstate.import_row_ids.size()) {
+			throw InvalidInputException("The HNSW index in '%s' has %llu vectors, but the table has %llu rows",
+			                            gstate.import_path, gstate.import_row_ids.size(), gstate.loaded_count.load());
+		}
+		gstate.built_count = gstate.loaded_count.load();
+
+		// There is nothing left to build, the construction only registers the index
+		auto new_event = make_shared_ptr<HNSWIndexConstructionEvent>(gstate, pipeline, *info, storage_ids, table);
+		event.InsertEvent(std::move(new_event));
+		return SinkFinalizeType::READY;
+	}
+
+	if (!gstate.source_index_name.empty()) {
+		// The table holds the rows of the source table in the same order if it was copied from it, but its row ids
+		// differ if the source table has gaps left by deleted rows. Map the vectors to the rows in order.
+		if (gstate.copy_row_ids.size() != gstate.import_row_ids.size()) {
+			throw InvalidInputException("HNSW index '%s' has %llu vectors, but the table has %llu rows",
+			                            gstate.source_index_name, gstate.import_row_ids.size(),
+			                            gstate.copy_row_ids.size());
+		}
+		std::sort(gstate.copy_row_ids.begin(), gstate.copy_row_ids.end());
+
+		// Tables copied in another order, e.g. with an ORDER BY or without preserving the insertion order, hold the
+		// same rows in another order, which this mapping would attach the wrong vectors to
+		vector<row_t> mapped_row_ids;
+		for (auto &row_id : gstate.copy_sample_row_ids) {
+			auto entry = std::lower_bound(gstate.copy_row_ids.begin(), gstate.copy_row_ids.end(), row_id);
+			mapped_row_ids.push_back(gstate.import_row_ids[NumericCast<idx_t>(entry - gstate.copy_row_ids.begin())]);
+		}
+		auto mismatch = gstate.global_index->FindMismatchedVector(gstate.copy_sample_vectors.data(),
+		                                                          mapped_row_ids.data(), mapped_row_ids.size());
+		if (mismatch.IsValid()) {
+			throw InvalidInputException("Row %lld of the table holds another vector than the row it is mapped to in "
+			                            "HNSW index '%s', the table holds its rows in another order. Create the "
+			                            "index without from_index instead",
+			                            gstate.copy_sample_row_ids[mismatch.GetIndex()], gstate.source_index_name);
+		}
+
+		if (gstate.copy_row_ids != gstate.import_row_ids) {
+			gstate.global_index->RemapRowIds(gstate.import_row_ids, gstate.copy_row_ids);
+		}
+		gstate.built_count = gstate.loaded_count.load();
+
+		// There is nothing left to build, the construction only registers the index
+		auto new_event = make_shared_ptr<HNSWIndexConstructionEvent>(gstate, pipeline, *info, storage_ids, table);
+		event.InsertEvent(std::move(new_event));
+		return SinkFinalizeType::READY;
+	}
+
+	// Switch to wide slots if the row count was underestimated, the graph is still empty unless streaming
+	auto &index = gstate.global_index->index;
+	if (gstate.loaded_count > index.max_size()) {
+		if (!gstate.pick_slot_bytes || gstate.streaming) {
+			throw InvalidInputException("HNSW index '%s' cannot hold more than %llu vectors with slot_bytes = %llu",
+			                            info->index_name, index.max_size(), index.slot_bytes());
+		}
+		index.widen();
+		gstate.options["slot_bytes"] = Value::INTEGER(static_cast<int32_t>(HNSWGraph::WIDE_SLOT_BYTES));
+	}
+
+	if (gstate.streaming) {
+		// The vectors were inserted while sinking, so the construction only registers the index
+		auto new_event = make_shared_ptr<HNSWIndexConstructionEvent>(gstate, pipeline, *info, storage_ids, table);
+		event.InsertEvent(std::move(new_event));
+		return SinkFinalizeType::READY;
+	}
+
+	// Fail early if the graph will not fit into the memory budget, before reserving it
+	CheckBuildMemory(gstate, gstate.loaded_count);
+
+	// Learn the projection from a sample of the data, if the index projects its vectors
+	if (gstate.global_index->HasProjection()) {
+		const auto array_size = ArrayType::GetSize(collection->Types()[0]);
+		auto sample = HNSWProjection::SampleVectors(*collection, HNSWProjection::SAMPLE_SIZE);
+		gstate.global_index->LearnProjection(sample.data(), sample.size() / array_size);
+	}
+
 	// Reserve the index size
 	auto &ts = TaskScheduler::GetScheduler(context);
-	auto &index = gstate.global_index->index;
 	index.reserve({static_cast<size_t>(collection->Count()), static_cast<size_t>(ts.NumberOfThreads())});
 
-	// Initialize a parallel scan for the index construction
-	collection->InitializeScan(gstate.scan_state, ColumnDataScanProperties::ALLOW_ZERO_COPY);
+	// Insert the vectors in another order than they were scanned in, if requested
+	string build_order = HNSWBuildOrder::SCAN;
+	auto build_order_opt = gstate.options.find("build_order");
+	if (build_order_opt != gstate.options.end()) {
+		build_order = build_order_opt->second.GetValue<string>();
+	}
+
+	auto hierarchical_opt = gstate.options.find("hierarchical_build");
+	gstate.hierarchical_build = hierarchical_opt != gstate.options.end() && hierarchical_opt->second.GetValue<bool>();
+
+	if (StringUtil::CIEquals(build_order, HNSWBuildOrder::SCAN) && !gstate.hierarchical_build) {
+		// Initialize a parallel scan for the index construction
+		collection->InitializeScan(gstate.scan_state, ColumnDataScanProperties::ALLOW_ZERO_COPY);
+	} else {
+		const auto array_size = ArrayType::GetSize(collection->Types()[0]);
+		const auto count = collection->Count();
+		MaterializeVectors(gstate);
+
+		RandomEngine engine;
+		if (StringUtil::CIEquals(build_order, HNSWBuildOrder::CLUSTER)) {
+			gstate.build_order =
+			    HNSWBuildOrder::ClusterInterleave(gstate.build_vectors.get(), count, array_size, engine);
+		} else if (StringUtil::CIEquals(build_order, HNSWBuildOrder::SHUFFLE)) {
+			gstate.build_order = HNSWBuildOrder::Shuffle(count, engine);
+		} else {
+			gstate.build_order.resize(count);
+			for (idx_t i = 0; i < count; i++) {
+				gstate.build_order[i] = i;
+			}
+		}
+
+		const auto threads = NumericCast<idx_t>(ts.NumberOfThreads());
+		if (gstate.hierarchical_build) {
+			// Draw the level of every vector the way usearch would, and move the vectors that reach the upper levels
+			// to the front. They are inserted first, so that the rest can be inserted into the base level without
+			// updating the upper levels or the entry point.
+			const auto connectivity = static_cast<double>(index.config().connectivity);
+			const auto upper_count = HNSWBuildOrder::PartitionUpperLevels(gstate.build_order, gstate.upper_levels,
+			                                                              connectivity, engine);
+			gstate.StartBuildPhase(0, upper_count, threads);
+		} else {
+			gstate.StartBuildPhase(0, count, threads);
+		}
+	}
 
 	// Create a new event that will construct the index
 	auto new_event = make_shared_ptr<HNSWIndexConstructionEvent>(gstate, pipeline, *info, storage_ids, table);
@@ -305,13 +815,19 @@ double PhysicalCreateHNSWIndex::GetSinkProgress(ClientContext &context, GlobalSi
                                                 double source_progress) const {
 	// The "source_progress" is not relevant for CREATE INDEX statements
 	const auto &state = gstate.Cast<CreateHNSWIndexGlobalState>();
+	const auto loaded_count = static_cast<double>(state.loaded_count);
 	// First half of the progress is appending to the collection
 	if (!state.is_building) {
-		return 50.0 *
-		       MinValue(1.0, static_cast<double>(state.loaded_count) / static_cast<double>(estimated_cardinality));
+		if (estimated_cardinality == 0) {
+			return 0.0;
+		}
+		return 50.0 * MinValue(1.0, loaded_count / static_cast<double>(estimated_cardinality));
+	}
+	// Second half is actually building the index, which is updated after every chunk added to the graph
+	if (loaded_count == 0) {
+		return 100.0;
 	}
-	// Second half is actually building the index
-	return 50.0 + (50.0 * static_cast<double>(state.built_count) / static_cast<double>(state.loaded_count));
+	return 50.0 + (50.0 * MinValue(1.0, static_cast<double>(state.built_count) / loaded_count));
 }
 
 } // namespace duckdb
\ No newline at end of file
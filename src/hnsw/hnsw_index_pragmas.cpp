@@ -8,9 +8,11 @@
 #include "duckdb/storage/table/scan_state.hpp"
 #include "duckdb/transaction/duck_transaction.hpp"
 #include "duckdb/transaction/local_storage.hpp"
+#include "duckdb/transaction/meta_transaction.hpp"
 #include "duckdb/main/extension_util.hpp"
 #include "duckdb/catalog/catalog_entry/duck_index_entry.hpp"
 #include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/object_cache.hpp"
 
 #include "hnsw/hnsw.hpp"
 #include "hnsw/hnsw_index.hpp"
@@ -57,6 +59,33 @@ static unique_ptr<FunctionData> HNSWindexInfoBind(ClientContext &context, TableF
 	                                                                 {"max_edges", LogicalType::BIGINT},
 	                                                                 {"allocated_bytes", LogicalType::BIGINT}})));
 
+	names.emplace_back("shared_lock_acquisitions");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("shared_lock_wait_us");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("exclusive_lock_acquisitions");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("exclusive_lock_wait_us");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("isa");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("slot_bytes");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("ef_search");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("huge_pages");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("warmups");
+	return_types.emplace_back(LogicalType::BIGINT);
+
 	return nullptr;
 }
 
@@ -142,6 +171,16 @@ static void HNSWIndexInfoExecute(ClientContext &context, TableFunctionInput &dat
 
 		output.data[col++].SetValue(row, level_stat_value);
 
+		output.data[col++].SetValue(row, Value::BIGINT(stats->lock_stats.shared_acquisitions));
+		output.data[col++].SetValue(row, Value::BIGINT(stats->lock_stats.shared_wait_us));
+		output.data[col++].SetValue(row, Value::BIGINT(stats->lock_stats.exclusive_acquisitions));
+		output.data[col++].SetValue(row, Value::BIGINT(stats->lock_stats.exclusive_wait_us));
+		output.data[col++].SetValue(row, Value(stats->isa));
+		output.data[col++].SetValue(row, Value::BIGINT(stats->slot_bytes));
+		output.data[col++].SetValue(row, Value::BIGINT(stats->ef_search));
+		output.data[col++].SetValue(row, Value(stats->huge_pages));
+		output.data[col++].SetValue(row, Value::BIGINT(stats->warmups));
+
 		row++;
 	}
 	output.SetCardinality(row);
@@ -151,6 +190,56 @@ static void HNSWIndexInfoExecute(ClientContext &context, TableFunctionInput &dat
 // Compact PRAGMA
 //-------------------------------------------------------------------------
 
+//! A compaction running in the database
+struct HNSWCompactionEntry {
+	string catalog_name;
+	string schema_name;
+	string index_name;
+	string table_name;
+	HNSWCompactionProgress progress;
+};
+
+//! The compactions running in the database. Kept outside of the indexes, so that their progress can be queried
+//! without waiting for the index lock held by the compaction
+class HNSWCompactionRegistry : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "hnsw_compaction_registry";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+
+	static HNSWCompactionRegistry &Get(ClientContext &context) {
+		return *ObjectCache::GetObjectCache(context).GetOrCreate<HNSWCompactionRegistry>(ObjectType());
+	}
+
+	shared_ptr<HNSWCompactionEntry> Register(const IndexCatalogEntry &index_entry) {
+		auto entry = make_shared_ptr<HNSWCompactionEntry>();
+		entry->catalog_name = index_entry.catalog.GetName();
+		entry->schema_name = index_entry.schema.name;
+		entry->index_name = index_entry.name;
+		entry->table_name = index_entry.GetTableName();
+		lock_guard<mutex> guard(lock);
+		entries.push_back(entry);
+		return entry;
+	}
+
+	void Unregister(const shared_ptr<HNSWCompactionEntry> &entry) {
+		lock_guard<mutex> guard(lock);
+		entries.erase(std::remove(entries.begin(), entries.end(), entry), entries.end());
+	}
+
+	vector<shared_ptr<HNSWCompactionEntry>> GetEntries() {
+		lock_guard<mutex> guard(lock);
+		return entries;
+	}
+
+private:
+	mutex lock;
+	vector<shared_ptr<HNSWCompactionEntry>> entries;
+};
+
 static void CompactIndexPragma(ClientContext &context, const FunctionParameters &parameters) {
 	if (parameters.values.size() != 1) {
 		throw BinderException("Expected one argument for hnsw_compact_index");
@@ -161,32 +250,206 @@ static void CompactIndexPragma(ClientContext &context, const FunctionParameters
 	}
 	auto index_name = param.GetValue<string>();
 
-	auto qname = QualifiedName::Parse(index_name);
-
-	// look up the index name in the catalog
-	Binder::BindSchemaOrCatalog(context, qname.catalog, qname.schema);
-	auto &index_entry = Catalog::GetEntry(context, CatalogType::INDEX_ENTRY, qname.catalog, qname.schema, qname.name)
-	                        .Cast<IndexCatalogEntry>();
-	auto &table_entry = Catalog::GetEntry(context, CatalogType::TABLE_ENTRY, qname.catalog, index_entry.GetSchemaName(),
-	                                      index_entry.GetTableName())
-	                        .Cast<TableCatalogEntry>();
-
-	auto &storage = table_entry.GetStorage();
-	bool found_index = false;
-
-	auto &table_info = *storage.GetDataTableInfo();
-	table_info.GetIndexes().BindAndScan<HNSWIndex>(context, table_info, [&](HNSWIndex &hnsw_index) {
-		if (index_entry.name == index_name) {
-			hnsw_index.Compact();
-			found_index = true;
-			return true;
+	auto lookup = LookupHNSWIndex(context, index_name);
+	auto &registry = HNSWCompactionRegistry::Get(context);
+	auto compaction = registry.Register(lookup.index_entry);
+	try {
+		lookup.index.Compact(context, compaction->progress);
+	} catch (...) {
+		registry.Unregister(compaction);
+		throw;
+	}
+	registry.Unregister(compaction);
+}
+
+//-------------------------------------------------------------------------
+// Warmup PRAGMA
+//-------------------------------------------------------------------------
+
+static void WarmupIndexPragma(ClientContext &context, const FunctionParameters &parameters) {
+	auto &param = parameters.values[0];
+	if (param.IsNull()) {
+		throw BinderException("Expected an index name for hnsw_warmup");
+	}
+	auto index_name = param.GetValue<string>();
+
+	auto queries = HNSWIndex::DEFAULT_WARMUP_QUERIES;
+	if (parameters.values.size() > 1) {
+		auto &queries_param = parameters.values[1];
+		if (queries_param.IsNull() || queries_param.GetValue<int64_t>() < 0) {
+			throw BinderException("The number of queries for hnsw_warmup must be non-negative");
+		}
+		queries = queries_param.GetValue<idx_t>();
+	}
+
+	LookupHNSWIndex(context, index_name).index.Warmup(queries);
+}
+
+//-------------------------------------------------------------------------
+// Export PRAGMA
+//-------------------------------------------------------------------------
+
+static void ExportIndexPragma(ClientContext &context, const FunctionParameters &parameters) {
+	if (parameters.values[0].IsNull() || parameters.values[1].IsNull()) {
+		throw BinderException("Expected an index name and a file path for hnsw_export_index");
+	}
+	auto index_name = parameters.values[0].GetValue<string>();
+	auto path = parameters.values[1].GetValue<string>();
+
+	LookupHNSWIndex(context, index_name).index.Export(context, path);
+}
+
+//-------------------------------------------------------------------------
+// Rebuild PRAGMA
+//-------------------------------------------------------------------------
+
+//! The metric an index is built with, the same default as the index uses
+static string GetMetricName(const case_insensitive_map_t<Value> &options) {
+	auto entry = options.find("metric");
+	return entry == options.end() ? "l2sq" : entry->second.GetValue<string>();
+}
+
+static void RebuildIndexPragma(ClientContext &context, const FunctionParameters &parameters) {
+	auto &param = parameters.values[0];
+	if (param.IsNull()) {
+		throw BinderException("Expected an index name for hnsw_rebuild_index");
+	}
+	auto index_name = param.GetValue<string>();
+	auto lookup = LookupHNSWIndex(context, index_name);
+
+	// The new options are stored in the catalog entry of the index, which a checkpoint must not write out while they
+	// are replaced. Modifying the database holds off checkpoints until the transaction ends.
+	MetaTransaction::Get(context).ModifyDatabase(lookup.index_entry.catalog.GetAttached());
+
+	// Start out from the options the index was created with, and replace the given ones
+	auto options = lookup.index.GetEntryOptions(lookup.index_entry);
+	const auto old_metric = GetMetricName(options);
+	for (auto &named_param : parameters.named_parameters) {
+		if (named_param.second.IsNull()) {
+			throw BinderException("HNSW index '%s' must not be NULL", named_param.first);
+		}
+		options[named_param.first] = named_param.second;
+	}
+
+	auto &key_expr = *lookup.index.unbound_expressions[0];
+	HNSWIndex::VerifyOptions(options, key_expr.return_type, key_expr.type == ExpressionType::BOUND_COLUMN_REF);
+
+	// Plans that were bound against the index, e.g. prepared statements, order by the distance function of its
+	// metric, and would silently return rows in the order of another one
+	auto new_metric = GetMetricName(options);
+	if (!StringUtil::CIEquals(old_metric, new_metric)) {
+		throw BinderException("The metric of HNSW index '%s' cannot be changed by rebuilding it, drop and re-create "
+		                      "the index with metric '%s' instead",
+		                      index_name, new_metric);
+	}
+
+	lookup.index.Rebuild(context, lookup.table_entry.GetStorage(), options);
+
+	// Keep the new options with the index, so that the graph is loaded with them again. Like the graph itself, they
+	// are not part of the transaction: they are written out at the next checkpoint and not undone by a rollback.
+	lookup.index.SetEntryOptions(lookup.index_entry, std::move(options));
+}
+
+//-------------------------------------------------------------------------
+// Alter Index
+//-------------------------------------------------------------------------
+
+static void AlterIndexPragma(ClientContext &context, const FunctionParameters &parameters) {
+	auto &param = parameters.values[0];
+	if (param.IsNull()) {
+		throw BinderException("Expected an index name for hnsw_alter_index");
+	}
+	auto index_name = param.GetValue<string>();
+	if (parameters.named_parameters.empty()) {
+		throw BinderException("Expected an option to change for hnsw_alter_index");
+	}
+
+	auto lookup = LookupHNSWIndex(context, index_name);
+	// Hold off checkpoints while the options of the catalog entry are replaced, like a rebuild
+	MetaTransaction::Get(context).ModifyDatabase(lookup.index_entry.catalog.GetAttached());
+
+	// Only the options that take effect without rebuilding the graph can be changed, which are checked like the
+	// options of a new index
+	auto options = lookup.index.GetEntryOptions(lookup.index_entry);
+	for (auto &named_param : parameters.named_parameters) {
+		if (named_param.second.IsNull()) {
+			throw BinderException("HNSW index '%s' must not be NULL", named_param.first);
 		}
-		return false;
-	});
+		options[named_param.first] = named_param.second;
+	}
+
+	auto &key_expr = *lookup.index.unbound_expressions[0];
+	HNSWIndex::VerifyOptions(options, key_expr.return_type, key_expr.type == ExpressionType::BOUND_COLUMN_REF);
+	lookup.index.SetSearchExpansion(options["ef_search"].GetValue<int32_t>());
+
+	// Keep the new options with the index, so that the graph is loaded with them again. Like a rebuild, this is not
+	// part of the transaction: the options are written out at the next checkpoint and not undone by a rollback.
+	lookup.index.SetEntryOptions(lookup.index_entry, std::move(options));
+}
+
+//-------------------------------------------------------------------------
+// Compaction Progress
+//-------------------------------------------------------------------------
+
+static unique_ptr<FunctionData> HNSWCompactionProgressBind(ClientContext &context, TableFunctionBindInput &input,
+                                                           vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("catalog_name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("schema_name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("index_name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("table_name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	names.emplace_back("processed");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("total");
+	return_types.emplace_back(LogicalType::BIGINT);
+
+	names.emplace_back("percentage");
+	return_types.emplace_back(LogicalType::DOUBLE);
+
+	return nullptr;
+}
 
-	if (!found_index) {
-		throw BinderException("Index %s not found", index_name);
+struct HNSWCompactionProgressGlobalState : public GlobalTableFunctionState {
+	idx_t offset = 0;
+	vector<shared_ptr<HNSWCompactionEntry>> entries;
+};
+
+static unique_ptr<GlobalTableFunctionState> HNSWCompactionProgressInitGlobal(ClientContext &context,
+                                                                             TableFunctionInitInput &input) {
+	auto result = make_uniq<HNSWCompactionProgressGlobalState>();
+	result->entries = HNSWCompactionRegistry::Get(context).GetEntries();
+	return std::move(result);
+}
+
+static void HNSWCompactionProgressExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.global_state->Cast<HNSWCompactionProgressGlobalState>();
+
+	idx_t row = 0;
+	while (data.offset < data.entries.size() && row < STANDARD_VECTOR_SIZE) {
+		auto &entry = *data.entries[data.offset++];
+		const auto processed = entry.progress.processed.load();
+		const auto total = entry.progress.total.load();
+
+		idx_t col = 0;
+		output.data[col++].SetValue(row, Value(entry.catalog_name));
+		output.data[col++].SetValue(row, Value(entry.schema_name));
+		output.data[col++].SetValue(row, Value(entry.index_name));
+		output.data[col++].SetValue(row, Value(entry.table_name));
+		output.data[col++].SetValue(row, Value::BIGINT(processed));
+		output.data[col++].SetValue(row, Value::BIGINT(total));
+		output.data[col++].SetValue(
+		    row, Value::DOUBLE(total == 0 ? 0.0 : 100.0 * static_cast<double>(processed) / static_cast<double>(total)));
+		row++;
 	}
+	output.SetCardinality(row);
 }
 
 //-------------------------------------------------------------------------
@@ -196,10 +459,44 @@ void HNSWModule::RegisterIndexPragmas(DatabaseInstance &db) {
 	ExtensionUtil::RegisterFunction(
 	    db, PragmaFunction::PragmaCall("hnsw_compact_index", CompactIndexPragma, {LogicalType::VARCHAR}));
 
+	ExtensionUtil::RegisterFunction(db, PragmaFunction::PragmaCall("hnsw_export_index", ExportIndexPragma,
+	                                                               {LogicalType::VARCHAR, LogicalType::VARCHAR}));
+
+	// The options that can be changed by a rebuild, the other ones only affect how the index is created
+	auto rebuild_function =
+	    PragmaFunction::PragmaCall("hnsw_rebuild_index", RebuildIndexPragma, {LogicalType::VARCHAR});
+	rebuild_function.named_parameters["metric"] = LogicalType::VARCHAR;
+	rebuild_function.named_parameters["ef_construction"] = LogicalType::INTEGER;
+	rebuild_function.named_parameters["ef_search"] = LogicalType::INTEGER;
+	rebuild_function.named_parameters["m"] = LogicalType::INTEGER;
+	rebuild_function.named_parameters["m0"] = LogicalType::INTEGER;
+	rebuild_function.named_parameters["search_dims"] = LogicalType::INTEGER;
+	rebuild_function.named_parameters["projection"] = LogicalType::VARCHAR;
+	rebuild_function.named_parameters["projection_dims"] = LogicalType::INTEGER;
+	rebuild_function.named_parameters["rerank"] = LogicalType::BOOLEAN;
+	rebuild_function.named_parameters["slot_bytes"] = LogicalType::INTEGER;
+	rebuild_function.named_parameters["compress_neighbors"] = LogicalType::BOOLEAN;
+	rebuild_function.named_parameters["huge_pages"] = LogicalType::VARCHAR;
+	ExtensionUtil::RegisterFunction(db, rebuild_function);
+
+	auto alter_function = PragmaFunction::PragmaCall("hnsw_alter_index", AlterIndexPragma, {LogicalType::VARCHAR});
+	alter_function.named_parameters["ef_search"] = LogicalType::INTEGER;
+	ExtensionUtil::RegisterFunction(db, alter_function);
+
+	PragmaFunctionSet warmup_set("hnsw_warmup");
+	warmup_set.AddFunction(PragmaFunction::PragmaCall("hnsw_warmup", WarmupIndexPragma, {LogicalType::VARCHAR}));
+	warmup_set.AddFunction(
+	    PragmaFunction::PragmaCall("hnsw_warmup", WarmupIndexPragma, {LogicalType::VARCHAR, LogicalType::BIGINT}));
+	ExtensionUtil::RegisterFunction(db, warmup_set);
+
 	// TODO: This is kind of ugly and maybe should just take a parameter instead...
 	TableFunction info_function("pragma_hnsw_index_info", {}, HNSWIndexInfoExecute, HNSWindexInfoBind,
 	                            HNSWIndexInfoInitGlobal);
 	ExtensionUtil::RegisterFunction(db, info_function);
+
+	TableFunction compaction_progress_function("pragma_hnsw_compaction_progress", {}, HNSWCompactionProgressExecute,
+	                                           HNSWCompactionProgressBind, HNSWCompactionProgressInitGlobal);
+	ExtensionUtil::RegisterFunction(db, compaction_progress_function);
 }
 
 } // namespace duckdb
\ No newline at end of file
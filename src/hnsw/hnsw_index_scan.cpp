@@ -60,8 +60,11 @@ static unique_ptr<GlobalTableFunctionState> HNSWIndexScanInitGlobal(ClientContex
 	local_storage.InitializeScan(bind_data.table.GetStorage(), result->local_storage_state.local_state, input.filters);
 
 	// Initialize the scan state for the index
-	result->index_state =
-	    bind_data.index.Cast<HNSWIndex>().InitializeScan(bind_data.query.get(), bind_data.limit, context);
+	auto &hnsw_index = bind_data.index.Cast<HNSWIndex>();
+	result->index_state = hnsw_index.InitializeScan(bind_data.table, bind_data.query.get(), bind_data.limit, context);
+
+	// Re-rank the candidates with the full vectors if the index only covers some of the dimensions
+	hnsw_index.RefineScan(*result->index_state, bind_data.table, context, bind_data.query.get(), bind_data.limit);
 
 	return std::move(result);
 }
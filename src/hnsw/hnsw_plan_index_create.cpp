@@ -2,6 +2,7 @@
 #include "duckdb/planner/operator/logical_create_index.hpp"
 #include "duckdb/parser/parsed_data/create_index_info.hpp"
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/main/config.hpp"
 
 #include "hnsw/hnsw.hpp"
 #include "hnsw/hnsw_index.hpp"
@@ -43,61 +44,12 @@ public:
 			                      "option 'hnsw_enable_experimental_persistence' is set to true.");
 		}
 
-		// Verify the options
-		for (auto &option : create_index.info->options) {
-			auto &k = option.first;
-			auto &v = option.second;
-			if (StringUtil::CIEquals(k, "metric")) {
-				if (v.type() != LogicalType::VARCHAR) {
-					throw BinderException("HNSW index 'metric' must be a string");
-				}
-				auto metric = v.GetValue<string>();
-				if (HNSWIndex::METRIC_KIND_MAP.find(metric) == HNSWIndex::METRIC_KIND_MAP.end()) {
-					vector<string> allowed_metrics;
-					for (auto &entry : HNSWIndex::METRIC_KIND_MAP) {
-						allowed_metrics.push_back(StringUtil::Format("'%s'", entry.first));
-					}
-					throw BinderException("HNSW index 'metric' must be one of: %s",
-					                      StringUtil::Join(allowed_metrics, ", "));
-				}
-			} else if (StringUtil::CIEquals(k, "ef_construction")) {
-				if (v.type() != LogicalType::INTEGER) {
-					throw BinderException("HNSW index 'ef_construction' must be an integer");
-				}
-				if (v.GetValue<int32_t>() < 1) {
-					throw BinderException("HNSW index 'ef_construction' must be at least 1");
-				}
-			} else if (StringUtil::CIEquals(k, "ef_search")) {
-				if (v.type() != LogicalType::INTEGER) {
-					throw BinderException("HNSW index 'ef_search' must be an integer");
-				}
-				if (v.GetValue<int32_t>() < 1) {
-					throw BinderException("HNSW index 'ef_search' must be at least 1");
-				}
-			} else if (StringUtil::CIEquals(k, "M")) {
-				if (v.type() != LogicalType::INTEGER) {
-					throw BinderException("HNSW index 'M' must be an integer");
-				}
-				if (v.GetValue<int32_t>() < 2) {
-					throw BinderException("HNSW index 'M' must be at least 2");
-				}
-			} else if (StringUtil::CIEquals(k, "M0")) {
-				if (v.type() != LogicalType::INTEGER) {
-					throw BinderException("HNSW index 'M0' must be an integer");
-				}
-				if (v.GetValue<int32_t>() < 2) {
-					throw BinderException("HNSW index 'M0' must be at least 2");
-				}
-			} else {
-				throw BinderException("Unknown option for HNSW index: '%s'", k);
-			}
-		}
-
 		// Verify the expression type
 		if (create_index.expressions.size() != 1) {
 			throw BinderException("HNSW indexes can only be created over a single column of keys.");
 		}
-		auto &arr_type = create_index.expressions[0]->return_type;
+		auto &key_expr = *create_index.expressions[0];
+		auto &arr_type = key_expr.return_type;
 		if (arr_type.id() != LogicalTypeId::ARRAY) {
 			throw BinderException("HNSW index keys must be of type FLOAT[N]");
 		}
@@ -112,6 +64,10 @@ public:
 			throw BinderException("HNSW index key type must be one of: %s", StringUtil::Join(allowed_types, ", "));
 		}
 
+		// Verify the options
+		HNSWIndex::VerifyOptions(create_index.info->options, arr_type,
+		                         key_expr.type == ExpressionType::BOUND_COLUMN_REF);
+
 		// We have a create index operator for our index
 		// We can replace this with a operator that creates the index
 		// The "LogicalCreateHNSWINdex" operator is a custom operator that we defined in the extension
@@ -1,8 +1,10 @@
 #include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
 #include "duckdb/optimizer/column_lifetime_analyzer.hpp"
 #include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_projection.hpp"
 #include "duckdb/planner/operator/logical_top_n.hpp"
@@ -18,6 +20,52 @@ namespace duckdb {
 //-----------------------------------------------------------------------------
 // Plan rewriter
 //-----------------------------------------------------------------------------
+static constexpr const char *INDEX_SELECTION_SETTING = "hnsw_index_selection";
+
+static string GetIndexSelection(ClientContext &context) {
+	Value selection;
+	if (context.TryGetCurrentSetting(INDEX_SELECTION_SETTING, selection) && !selection.IsNull()) {
+		return selection.ToString();
+	}
+	return "cost";
+}
+
+static void SetIndexSelection(ClientContext &context, SetScope scope, Value &parameter) {
+	auto selection = StringUtil::Lower(parameter.ToString());
+	if (selection != "cost" && selection != "recall") {
+		throw InvalidInputException("%s must be one of: 'cost', 'recall'", INDEX_SELECTION_SETTING);
+	}
+	parameter = Value(selection);
+}
+
+// Rewrite "expr" to reference the columns of the table scanned by "get" by their storage index, like the expressions
+// indexes are bound with. Returns false if it references anything else, e.g. the row id or the output of another
+// operator.
+static bool BindToStorage(unique_ptr<Expression> &expr, const LogicalGet &get, TableCatalogEntry &table) {
+	if (expr->type == ExpressionType::BOUND_COLUMN_REF) {
+		auto &column_ref = expr->Cast<BoundColumnRefExpression>();
+		if (column_ref.binding.table_index != get.table_index) {
+			return false;
+		}
+		auto column_index = column_ref.binding.column_index;
+		if (!get.projection_ids.empty()) {
+			column_index = get.projection_ids[column_index];
+		}
+		auto column_id = get.column_ids[column_index];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			return false;
+		}
+		auto storage_index = table.GetColumn(LogicalIndex(column_id)).StorageOid();
+		expr = make_uniq<BoundReferenceExpression>(expr->return_type, storage_index);
+		return true;
+	}
+	bool bound = true;
+	ExpressionIterator::EnumerateChildren(*expr, [&](unique_ptr<Expression> &child) {
+		bound = bound && BindToStorage(child, get, table);
+	});
+	return bound;
+}
+
 class HNSWIndexScanOptimizer : public OptimizerExtension {
 public:
 	HNSWIndexScanOptimizer() {
@@ -72,20 +120,20 @@ public:
 			return false;
 		}
 
-		// Figure out the query vector
+		// Figure out the query vector, and the vectors it is compared with
 		Value target_value;
+		optional_ptr<Expression> vector_expr;
 		if (bound_function.children[0]->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
 			target_value = bound_function.children[0]->Cast<BoundConstantExpression>().value;
+			vector_expr = bound_function.children[1].get();
 		} else if (bound_function.children[1]->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
 			target_value = bound_function.children[1]->Cast<BoundConstantExpression>().value;
+			vector_expr = bound_function.children[0].get();
 		} else {
 			// We can only optimize if one of the children is a constant
 			return false;
 		}
 
-		// TODO: We should check that the other argument to the distance function is a column reference
-		// that matches the column that the index is on. That also helps us identify the scan operator
-
 		auto value_type = target_value.type();
 		if (value_type.id() != LogicalTypeId::ARRAY) {
 			// We can only optimize if the constant is an array
@@ -132,11 +180,16 @@ public:
 		auto &duck_table = table.Cast<DuckTableEntry>();
 		auto &table_info = *table.GetStorage().GetDataTableInfo();
 
-		// Find the index
-		unique_ptr<HNSWIndexScanBindData> bind_data = nullptr;
-		table_info.GetIndexes().BindAndScan<HNSWIndex>(context, table_info, [&](HNSWIndex &index_entry) {
-			auto &hnsw_index = index_entry.Cast<HNSWIndex>();
+		// Figure out what the query vector is compared with in terms of the columns of the table, which an index has
+		// to be over to serve the query
+		auto vector_key = vector_expr->Copy();
+		if (!BindToStorage(vector_key, get, table)) {
+			return false;
+		}
 
+		// Find the indexes that could serve the query
+		vector<reference<HNSWIndex>> candidates;
+		table_info.GetIndexes().BindAndScan<HNSWIndex>(context, table_info, [&](HNSWIndex &hnsw_index) {
 			if (hnsw_index.GetVectorSize() != array_size) {
 				// The vector size of the index does not match the vector size of the query
 				return false;
@@ -147,23 +200,56 @@ public:
 				return false;
 			}
 
-			// Create a query vector from the constant value
-			auto query_vector = make_unsafe_uniq_array<float>(array_size);
-			auto vector_elements = ArrayValue::GetChildren(target_value);
-			for (idx_t i = 0; i < array_size; i++) {
-				query_vector[i] = vector_elements[i].GetValue<float>();
+			if (!hnsw_index.MatchesExpression(*vector_key)) {
+				// The index is over another column or expression than the one the query is compared with
+				return false;
 			}
 
-			// Create the bind data for this index
-			bind_data = make_uniq<HNSWIndexScanBindData>(duck_table, index_entry, top_n.limit, std::move(query_vector));
-			return true;
+			candidates.push_back(hnsw_index);
+			return false;
 		});
 
-		if (!bind_data) {
+		if (candidates.empty()) {
 			// No index found
 			return false;
 		}
 
+		// Pick the cheapest index, or the one with the best recall, depending on the hnsw_index_selection setting
+		auto prefer_recall = GetIndexSelection(context) == "recall";
+		optional_ptr<HNSWIndex> best_index;
+		HNSWScanEstimate best_estimate;
+		for (auto &candidate : candidates) {
+			auto estimate = candidate.get().EstimateScan(top_n.limit, context);
+			bool is_better;
+			if (!best_index) {
+				is_better = true;
+			} else if (prefer_recall) {
+				is_better = estimate.quality > best_estimate.quality ||
+				            (estimate.quality == best_estimate.quality && estimate.cost < best_estimate.cost);
+			} else {
+				is_better = estimate.cost < best_estimate.cost ||
+				            (estimate.cost == best_estimate.cost && estimate.quality > best_estimate.quality);
+			}
+			if (is_better) {
+				best_index = &candidate.get();
+				best_estimate = estimate;
+			}
+		}
+
+		// Pick up a vss_simd_target set since the index was last bound
+		best_index->ApplySimdTarget();
+
+		// Create a query vector from the constant value
+		auto query_vector = make_unsafe_uniq_array<float>(array_size);
+		auto vector_elements = ArrayValue::GetChildren(target_value);
+		for (idx_t i = 0; i < array_size; i++) {
+			query_vector[i] = vector_elements[i].GetValue<float>();
+		}
+
+		// Create the bind data for the chosen index
+		auto bind_data =
+		    make_uniq<HNSWIndexScanBindData>(duck_table, *best_index, top_n.limit, std::move(query_vector));
+
 		// Replace the scan with our custom index scan function
 
 		get.function = HNSWIndexScanFunction::GetFunction();
@@ -243,6 +329,11 @@ public:
 // Register
 //-----------------------------------------------------------------------------
 void HNSWModule::RegisterPlanIndexScan(DatabaseInstance &db) {
+	db.config.AddExtensionOption(INDEX_SELECTION_SETTING,
+	                             "how to choose between several HNSW indexes that could serve a query: 'cost' for the "
+	                             "cheapest one, or 'recall' for the one expected to find the most true neighbours",
+	                             LogicalType::VARCHAR, Value("cost"), SetIndexSelection);
+
 	// Register the optimizer extension
 	db.config.optimizer_extensions.push_back(HNSWIndexScanOptimizer());
 }
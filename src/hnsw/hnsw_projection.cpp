@@ -0,0 +1,170 @@
+#include "hnsw/hnsw_projection.hpp"
+
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+
+const case_insensitive_set_t HNSWProjection::KINDS = {"pca", "random"};
+
+HNSWProjection::HNSWProjection(idx_t input_dims, idx_t output_dims)
+    : input_dims(input_dims), output_dims(output_dims), matrix(input_dims * output_dims, 0.0f) {
+	D_ASSERT(output_dims <= input_dims);
+}
+
+static float DotProduct(const float *lhs, const float *rhs, idx_t count) {
+	float result = 0;
+	for (idx_t i = 0; i < count; i++) {
+		result += lhs[i] * rhs[i];
+	}
+	return result;
+}
+
+// Draw a standard normal variable using the Box-Muller transform
+static float NextGaussian(RandomEngine &engine) {
+	static constexpr const double PI = 3.14159265358979323846;
+	auto u1 = MaxValue(engine.NextRandom(), 1e-12);
+	auto u2 = engine.NextRandom();
+	return static_cast<float>(std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * PI * u2));
+}
+
+void HNSWProjection::Orthonormalize(RandomEngine &engine) {
+	for (idx_t i = 0; i < output_dims; i++) {
+		auto row = matrix.data() + i * input_dims;
+		while (true) {
+			// Remove the components of the previous rows
+			for (idx_t j = 0; j < i; j++) {
+				auto prev = matrix.data() + j * input_dims;
+				auto dot = DotProduct(row, prev, input_dims);
+				for (idx_t k = 0; k < input_dims; k++) {
+					row[k] -= dot * prev[k];
+				}
+			}
+			auto norm = std::sqrt(DotProduct(row, row, input_dims));
+			if (norm > 1e-6f) {
+				for (idx_t k = 0; k < input_dims; k++) {
+					row[k] /= norm;
+				}
+				break;
+			}
+			// The row is (close to) linearly dependent on the previous ones, e.g. because the sample is rank
+			// deficient. Replace it with a random direction and try again.
+			for (idx_t k = 0; k < input_dims; k++) {
+				row[k] = NextGaussian(engine);
+			}
+		}
+	}
+}
+
+void HNSWProjection::InitializeRandom(RandomEngine &engine) {
+	for (auto &val : matrix) {
+		val = NextGaussian(engine);
+	}
+	Orthonormalize(engine);
+}
+
+void HNSWProjection::InitializePCA(const float *sample, idx_t count, bool center, RandomEngine &engine) {
+	if (count == 0) {
+		InitializeRandom(engine);
+		return;
+	}
+
+	// Compute the mean of the sample
+	vector<float> mean(input_dims, 0.0f);
+	if (center) {
+		for (idx_t i = 0; i < count; i++) {
+			auto vec = sample + i * input_dims;
+			for (idx_t k = 0; k < input_dims; k++) {
+				mean[k] += vec[k];
+			}
+		}
+		for (auto &val : mean) {
+			val /= static_cast<float>(count);
+		}
+	}
+
+	// Compute the (upper triangle of the) covariance matrix
+	vector<float> covariance(input_dims * input_dims, 0.0f);
+	vector<float> centered(input_dims);
+	for (idx_t i = 0; i < count; i++) {
+		auto vec = sample + i * input_dims;
+		for (idx_t k = 0; k < input_dims; k++) {
+			centered[k] = vec[k] - mean[k];
+		}
+		for (idx_t r = 0; r < input_dims; r++) {
+			auto scale = centered[r];
+			auto cov_row = covariance.data() + r * input_dims;
+			for (idx_t c = r; c < input_dims; c++) {
+				cov_row[c] += scale * centered[c];
+			}
+		}
+	}
+	for (idx_t r = 0; r < input_dims; r++) {
+		for (idx_t c = 0; c < r; c++) {
+			covariance[r * input_dims + c] = covariance[c * input_dims + r];
+		}
+	}
+
+	// Find the subspace spanned by the leading eigenvectors using (block) subspace iteration
+	static constexpr const idx_t ITERATIONS = 8;
+
+	InitializeRandom(engine);
+	vector<float> next(matrix.size());
+	for (idx_t iteration = 0; iteration < ITERATIONS; iteration++) {
+		for (idx_t i = 0; i < output_dims; i++) {
+			auto row = matrix.data() + i * input_dims;
+			auto next_row = next.data() + i * input_dims;
+			for (idx_t r = 0; r < input_dims; r++) {
+				next_row[r] = DotProduct(covariance.data() + r * input_dims, row, input_dims);
+			}
+		}
+		std::swap(matrix, next);
+		Orthonormalize(engine);
+	}
+}
+
+void HNSWProjection::Project(const float *input, float *output) const {
+	for (idx_t i = 0; i < output_dims; i++) {
+		output[i] = DotProduct(matrix.data() + i * input_dims, input, input_dims);
+	}
+}
+
+vector<float> HNSWProjection::SampleVectors(ColumnDataCollection &collection, idx_t sample_size) {
+	const auto array_size = ArrayType::GetSize(collection.Types()[0]);
+
+	vector<float> sample;
+	sample.reserve(MinValue(sample_size, collection.Count()) * array_size);
+
+	RandomEngine engine;
+	idx_t seen = 0;
+	for (auto &chunk : collection.Chunks()) {
+		const auto count = chunk.size();
+		auto &vec_vec = chunk.data[0];
+		auto &data_vec = ArrayVector::GetEntry(vec_vec);
+
+		UnifiedVectorFormat vec_format;
+		UnifiedVectorFormat data_format;
+		vec_vec.ToUnifiedFormat(count, vec_format);
+		data_vec.ToUnifiedFormat(count * array_size, data_format);
+		const auto data_ptr = UnifiedVectorFormat::GetData<float>(data_format);
+
+		for (idx_t i = 0; i < count; i++) {
+			const auto vec_ptr = data_ptr + vec_format.sel->get_index(i) * array_size;
+			if (seen < sample_size) {
+				sample.insert(sample.end(), vec_ptr, vec_ptr + array_size);
+			} else {
+				// Replace a random element of the reservoir with decreasing probability
+				auto target = static_cast<idx_t>(engine.NextRandom() * static_cast<double>(seen + 1));
+				if (target < sample_size) {
+					std::copy(vec_ptr, vec_ptr + array_size, sample.begin() + static_cast<ptrdiff_t>(target * array_size));
+				}
+			}
+			seen++;
+		}
+	}
+	return sample;
+}
+
+} // namespace duckdb
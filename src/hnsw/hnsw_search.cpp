@@ -0,0 +1,276 @@
+#include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/catalog/dependency_list.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/extension_util.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/table/scan_state.hpp"
+#include "duckdb/transaction/duck_transaction.hpp"
+
+#include "hnsw/hnsw.hpp"
+#include "hnsw/hnsw_index.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+
+//-------------------------------------------------------------------------
+// Bind
+//-------------------------------------------------------------------------
+struct HNSWSearchBindData : public TableFunctionData {
+	HNSWSearchBindData(DuckTableEntry &table, HNSWIndex &index) : table(table), index(index) {
+	}
+
+	//! The table to search
+	DuckTableEntry &table;
+	//! The index to search
+	HNSWIndex &index;
+
+	//! The query vector
+	unsafe_unique_array<float> query;
+	//! The number of results
+	idx_t limit = 0;
+	//! The ef_search of this search, if it overrides the one of the index
+	optional_idx ef_search;
+	//! Whether to compare the query with every row of the table instead of searching the graph
+	bool exact = false;
+	//! The metric of the index, which determines how its distances are reported
+	string metric;
+
+	//! The storage ids of the columns to fetch
+	vector<storage_t> column_ids;
+
+public:
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<HNSWSearchBindData>();
+		if (&other.table != &table || &other.index != &index || other.limit != limit || other.exact != exact ||
+		    other.metric != metric || other.column_ids != column_ids) {
+			return false;
+		}
+		if (other.ef_search.IsValid() != ef_search.IsValid() ||
+		    (ef_search.IsValid() && other.ef_search.GetIndex() != ef_search.GetIndex())) {
+			return false;
+		}
+		auto vector_size = index.GetVectorSize();
+		return memcmp(other.query.get(), query.get(), vector_size * sizeof(float)) == 0;
+	}
+};
+
+//! Convert a distance in the metric of the index to the value of the distance function the index serves queries for:
+//! array_distance for l2sq, 1 - array_cosine_similarity for cosine and -array_inner_product for ip
+static float ToArrayDistance(const string &metric, float distance) {
+	if (metric == "l2sq") {
+		// The graph compares squared euclidean distances, which keep the order without taking the square root
+		return std::sqrt(MaxValue(distance, 0.0f));
+	}
+	if (metric == "ip") {
+		// The graph compares 1 - ip, so that the distance of a vector to itself is 0 for normalized vectors
+		return distance - 1.0f;
+	}
+	return distance;
+}
+
+static unique_ptr<FunctionData> HNSWSearchBind(ClientContext &context, TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types, vector<string> &names) {
+	for (auto &param : input.inputs) {
+		if (param.IsNull()) {
+			throw BinderException("hnsw_search: arguments cannot be NULL");
+		}
+	}
+
+	// Look up the table
+	auto qname = QualifiedName::Parse(input.inputs[0].GetValue<string>());
+	Binder::BindSchemaOrCatalog(context, qname.catalog, qname.schema);
+	auto &table_entry = Catalog::GetEntry(context, CatalogType::TABLE_ENTRY, qname.catalog, qname.schema, qname.name)
+	                        .Cast<TableCatalogEntry>();
+	if (!table_entry.IsDuckTable()) {
+		throw BinderException("hnsw_search: '%s' is not a DuckDB table", table_entry.name);
+	}
+	auto &table = table_entry.Cast<DuckTableEntry>();
+
+	// Find the index on the table
+	auto index_name = input.inputs[1].GetValue<string>();
+	optional_ptr<HNSWIndex> index;
+	auto &table_info = *table.GetStorage().GetDataTableInfo();
+	table_info.GetIndexes().BindAndScan<HNSWIndex>(context, table_info, [&](HNSWIndex &hnsw_index) {
+		if (hnsw_index.GetIndexName() != index_name) {
+			return false;
+		}
+		index = &hnsw_index;
+		return true;
+	});
+	if (!index) {
+		throw BinderException("hnsw_search: table '%s' has no HNSW index named '%s'", table.name, index_name);
+	}
+
+	// The query has to be a vector of floats of the same size as the indexed ones
+	auto vector_size = index->GetVectorSize();
+	auto query_value = input.inputs[2];
+	if (!query_value.DefaultTryCastAs(LogicalType::ARRAY(LogicalType::FLOAT, vector_size))) {
+		throw BinderException("hnsw_search: the query must be of type FLOAT[%llu], like the vectors of index '%s'",
+		                      vector_size, index_name);
+	}
+	auto &query_elements = ArrayValue::GetChildren(query_value);
+	for (auto &element : query_elements) {
+		if (element.IsNull()) {
+			throw BinderException("hnsw_search: the query must not contain NULL elements");
+		}
+	}
+
+	auto limit = input.inputs[3].GetValue<int64_t>();
+	if (limit < 1) {
+		throw BinderException("hnsw_search: 'k' must be at least 1");
+	}
+
+	// Pick up a vss_simd_target set since the index was last bound
+	index->ApplySimdTarget();
+
+	auto result = make_uniq<HNSWSearchBindData>(table, *index);
+	result->query = make_unsafe_uniq_array<float>(vector_size);
+	for (idx_t i = 0; i < vector_size; i++) {
+		result->query[i] = query_elements[i].GetValue<float>();
+	}
+	result->limit = static_cast<idx_t>(limit);
+	result->metric = index->GetMetric();
+
+	for (auto &kv : input.named_parameters) {
+		if (kv.second.IsNull()) {
+			throw BinderException("hnsw_search: '%s' cannot be NULL", kv.first);
+		}
+		if (kv.first == "ef") {
+			auto ef_search = kv.second.GetValue<int64_t>();
+			if (ef_search < 1) {
+				throw BinderException("hnsw_search: 'ef' must be at least 1");
+			}
+			result->ef_search = static_cast<idx_t>(ef_search);
+		} else if (kv.first == "exact") {
+			result->exact = kv.second.GetValue<bool>();
+		}
+	}
+
+	// Return all the columns of the table, followed by the distance to the query
+	for (auto &column : table.GetColumns().Physical()) {
+		names.push_back(column.Name());
+		return_types.push_back(column.Type());
+		result->column_ids.push_back(column.StorageOid());
+	}
+	names.emplace_back("distance");
+	return_types.emplace_back(LogicalType::FLOAT);
+
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Global State
+//-------------------------------------------------------------------------
+struct HNSWSearchGlobalState : public GlobalTableFunctionState {
+	//! The results, ordered by distance
+	unique_ptr<IndexScanState> index_state;
+	unordered_map<row_t, float> distances;
+
+	vector<storage_t> fetch_ids;
+	DataChunk fetch_chunk;
+	ColumnFetchState fetch_state;
+	Vector row_ids = Vector(LogicalType::ROW_TYPE);
+};
+
+static unique_ptr<GlobalTableFunctionState> HNSWSearchInitGlobal(ClientContext &context,
+                                                                 TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<HNSWSearchBindData>();
+	auto result = make_uniq<HNSWSearchGlobalState>();
+
+	auto &index = bind_data.index;
+	auto &table = bind_data.table;
+	auto query = bind_data.query.get();
+	if (bind_data.exact) {
+		result->index_state = index.InitializeExactScan(table, context, query, bind_data.limit);
+	} else {
+		result->index_state = index.InitializeScan(table, query, bind_data.limit, context, bind_data.ef_search);
+		// Re-rank the candidates with the full vectors if the index only covers some of the dimensions
+		index.RefineScan(*result->index_state, table, context, query, bind_data.limit);
+	}
+	auto &scan_state = result->index_state->Cast<HNSWIndexScanState>();
+	for (idx_t i = 0; i < scan_state.total_rows; i++) {
+		result->distances[scan_state.row_ids[i]] = ToArrayDistance(bind_data.metric, scan_state.distances[i]);
+	}
+
+	// Fetch the columns of the table together with the row ids, which are used to look up the distances of the rows
+	// that are visible to us
+	result->fetch_ids = bind_data.column_ids;
+	result->fetch_ids.push_back(COLUMN_IDENTIFIER);
+	auto fetch_types = bind_data.table.GetTypes();
+	fetch_types.push_back(LogicalType::ROW_TYPE);
+	result->fetch_chunk.Initialize(context, fetch_types);
+
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Execute
+//-------------------------------------------------------------------------
+static void HNSWSearchExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<HNSWSearchBindData>();
+	auto &state = data_p.global_state->Cast<HNSWSearchGlobalState>();
+	auto &transaction = DuckTransaction::Get(context, bind_data.table.catalog);
+	auto &storage = bind_data.table.GetStorage();
+
+	while (true) {
+		auto count = bind_data.index.Scan(*state.index_state, state.row_ids);
+		if (count == 0) {
+			break;
+		}
+
+		// Rows that are not visible to us are skipped by the fetch
+		state.fetch_chunk.Reset();
+		storage.Fetch(transaction, state.fetch_chunk, state.fetch_ids, state.row_ids, count, state.fetch_state);
+		if (state.fetch_chunk.size() == 0) {
+			continue;
+		}
+
+		const auto column_count = bind_data.column_ids.size();
+		for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+			output.data[col_idx].Reference(state.fetch_chunk.data[col_idx]);
+		}
+		auto fetched_row_ids = FlatVector::GetData<row_t>(state.fetch_chunk.data[column_count]);
+		auto distance_data = FlatVector::GetData<float>(output.data[column_count]);
+		for (idx_t i = 0; i < state.fetch_chunk.size(); i++) {
+			distance_data[i] = state.distances[fetched_row_ids[i]];
+		}
+		output.SetCardinality(state.fetch_chunk.size());
+		return;
+	}
+	output.SetCardinality(0);
+}
+
+//-------------------------------------------------------------------------
+// Dependency
+//-------------------------------------------------------------------------
+static void HNSWSearchDependency(LogicalDependencyList &entries, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<HNSWSearchBindData>();
+	entries.AddDependency(bind_data.table);
+}
+
+//-------------------------------------------------------------------------
+// Cardinality
+//-------------------------------------------------------------------------
+static unique_ptr<NodeStatistics> HNSWSearchCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<HNSWSearchBindData>();
+	return make_uniq<NodeStatistics>(bind_data.limit, bind_data.limit);
+}
+
+//-------------------------------------------------------------------------
+// Register
+//-------------------------------------------------------------------------
+void HNSWModule::RegisterSearch(DatabaseInstance &db) {
+	TableFunction func("hnsw_search",
+	                   {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::ANY, LogicalType::BIGINT},
+	                   HNSWSearchExecute, HNSWSearchBind, HNSWSearchInitGlobal);
+	func.named_parameters["ef"] = LogicalType::BIGINT;
+	func.named_parameters["exact"] = LogicalType::BOOLEAN;
+	func.dependency = HNSWSearchDependency;
+	func.cardinality = HNSWSearchCardinality;
+	ExtensionUtil::RegisterFunction(db, func);
+}
+
+} // namespace duckdb
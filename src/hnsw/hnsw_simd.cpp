@@ -0,0 +1,209 @@
+#include "hnsw/hnsw_simd.hpp"
+
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension_util.hpp"
+#include "hnsw/hnsw.hpp"
+#include "usearch/duckdb_usearch.hpp"
+
+#if DUCKDB_USEARCH_USE_SIMSIMD
+#ifndef SIMSIMD_NATIVE_F16
+#define SIMSIMD_NATIVE_F16 0
+#endif
+#include "simsimd/simsimd.h"
+#else
+// Without SimSIMD the index only has serial kernels, so the ISA levels are listed but never detected or used. The
+// values match the ones of SimSIMD
+enum simsimd_capability_t : uint32_t {
+	simsimd_cap_serial_k = 1,
+	simsimd_cap_neon_k = 1 << 10,
+	simsimd_cap_sve_k = 1 << 11,
+	simsimd_cap_haswell_k = 1 << 20,
+	simsimd_cap_skylake_k = 1 << 21,
+	simsimd_cap_ice_k = 1 << 22,
+	simsimd_cap_sapphire_k = 1 << 23,
+	simsimd_cap_genoa_k = 1 << 24
+};
+#endif
+
+namespace duckdb {
+
+//-------------------------------------------------------------------------
+// Targets
+//-------------------------------------------------------------------------
+struct SimdTarget {
+	const char *name;
+	simsimd_capability_t capability;
+};
+
+static const SimdTarget SIMD_TARGETS[] = {
+    {"serial", simsimd_cap_serial_k}, {"neon", simsimd_cap_neon_k},         {"sve", simsimd_cap_sve_k},
+    {"haswell", simsimd_cap_haswell_k}, {"skylake", simsimd_cap_skylake_k}, {"ice", simsimd_cap_ice_k},
+    {"sapphire", simsimd_cap_sapphire_k}, {"genoa", simsimd_cap_genoa_k}};
+
+// Common names of the x86 ISA levels
+static const case_insensitive_map_t<string> SIMD_TARGET_ALIASES = {{"avx2", "haswell"}, {"avx512", "skylake"}};
+
+static string CanonicalTargetName(const string &target) {
+	auto alias = SIMD_TARGET_ALIASES.find(target);
+	return StringUtil::Lower(alias == SIMD_TARGET_ALIASES.end() ? target : alias->second);
+}
+
+uint32_t HNSWSimd::GetCapabilities(const string &target) {
+	auto name = CanonicalTargetName(target);
+	if (name == "auto") {
+		return ALL_CAPABILITIES;
+	}
+	for (auto &entry : SIMD_TARGETS) {
+		if (name == entry.name) {
+			// The serial kernels cover what the ISA level has no kernel for
+			return entry.capability | simsimd_cap_serial_k;
+		}
+	}
+	vector<string> names = {"auto"};
+	for (auto &entry : SIMD_TARGETS) {
+		names.push_back(entry.name);
+	}
+	for (auto &alias : SIMD_TARGET_ALIASES) {
+		names.push_back(alias.first);
+	}
+	throw InvalidInputException("Unknown %s '%s', expected one of: %s", TARGET_SETTING, target,
+	                            StringUtil::Join(names, ", "));
+}
+
+uint32_t HNSWSimd::GetConfiguredCapabilities(DatabaseInstance &db) {
+	Value target;
+	if (db.TryGetCurrentSetting(TARGET_SETTING, target) && !target.IsNull()) {
+		return GetCapabilities(target.ToString());
+	}
+	return ALL_CAPABILITIES;
+}
+
+static bool IsSupported(simsimd_capability_t capability) {
+#if DUCKDB_USEARCH_USE_SIMSIMD
+	static const simsimd_capability_t supported = simsimd_capabilities();
+	return (supported & capability) != 0;
+#else
+	// Only SimSIMD detects the ISA levels of the CPU, the serial kernels run anywhere
+	return capability == simsimd_cap_serial_k;
+#endif
+}
+
+// Whether the index has kernels for the ISA level, the SimSIMD kernels of a level are only compiled in when the
+// compiler targets it
+static bool IsAvailable(simsimd_capability_t capability) {
+	if (capability == simsimd_cap_serial_k) {
+		return true;
+	}
+#if DUCKDB_USEARCH_USE_SIMSIMD
+	const simsimd_metric_kind_t metrics[] = {simsimd_metric_l2sq_k, simsimd_metric_hamming_k};
+	const simsimd_datatype_t datatypes[] = {simsimd_datatype_f32_k, simsimd_datatype_f16_k, simsimd_datatype_i8_k,
+	                                        simsimd_datatype_b8_k};
+	for (auto metric : metrics) {
+		for (auto datatype : datatypes) {
+			simsimd_metric_punned_t kernel = nullptr;
+			simsimd_capability_t used = simsimd_cap_serial_k;
+			simsimd_find_metric_punned(metric, datatype, capability, capability, &kernel, &used);
+			if (kernel && used == capability) {
+				return true;
+			}
+		}
+	}
+#endif
+	return false;
+}
+
+static void SetSimdTarget(ClientContext &context, SetScope scope, Value &parameter) {
+	// The kernels belong to the indexes, which all clients of the database share
+	if (scope == SetScope::LOCAL || scope == SetScope::SESSION) {
+		throw InvalidInputException("%s applies to the whole database, use SET GLOBAL %s instead",
+		                            HNSWSimd::TARGET_SETTING, HNSWSimd::TARGET_SETTING);
+	}
+	auto target = CanonicalTargetName(parameter.ToString());
+	HNSWSimd::GetCapabilities(target);
+	if (target != "auto") {
+		for (auto &entry : SIMD_TARGETS) {
+			if (target == entry.name && (!IsSupported(entry.capability) || !IsAvailable(entry.capability))) {
+				throw InvalidInputException("%s '%s' is not available, see vss_simd_capabilities() for the ISA levels "
+				                            "supported by this machine and build",
+				                            HNSWSimd::TARGET_SETTING, target);
+			}
+		}
+	}
+	parameter = Value(target);
+	// A plain SET only changes the setting of the client, so change the one of the database as well
+	if (scope == SetScope::AUTOMATIC) {
+		DBConfig::GetConfig(context).SetOption(HNSWSimd::TARGET_SETTING, parameter);
+	}
+}
+
+//-------------------------------------------------------------------------
+// Capabilities Table Function
+//-------------------------------------------------------------------------
+static unique_ptr<FunctionData> SimdCapabilitiesBind(ClientContext &context, TableFunctionBindInput &input,
+                                                     vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("isa");
+	return_types.emplace_back(LogicalType::VARCHAR);
+
+	// Whether the CPU supports the ISA level
+	names.emplace_back("supported");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+
+	// Whether the extension was built with kernels for the ISA level
+	names.emplace_back("available");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+
+	// Whether the ISA level is used for FLOAT vectors with the vss_simd_target of the database
+	names.emplace_back("selected");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+
+	return nullptr;
+}
+
+struct SimdCapabilitiesGlobalState : public GlobalTableFunctionState {
+	idx_t offset = 0;
+	string selected;
+};
+
+static unique_ptr<GlobalTableFunctionState> SimdCapabilitiesInitGlobal(ClientContext &context,
+                                                                       TableFunctionInitInput &input) {
+	auto result = make_uniq<SimdCapabilitiesGlobalState>();
+	auto capabilities = HNSWSimd::GetConfiguredCapabilities(DatabaseInstance::GetDatabase(context));
+	auto metric = unum::usearch::metric_punned_t::builtin_restricted(
+	    16, unum::usearch::metric_kind_t::l2sq_k, unum::usearch::scalar_kind_t::f32_k, capabilities);
+	result->selected = metric.isa_name();
+	return std::move(result);
+}
+
+static void SimdCapabilitiesExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &state = data_p.global_state->Cast<SimdCapabilitiesGlobalState>();
+
+	idx_t row = 0;
+	const auto target_count = sizeof(SIMD_TARGETS) / sizeof(SIMD_TARGETS[0]);
+	while (state.offset < target_count && row < STANDARD_VECTOR_SIZE) {
+		auto &target = SIMD_TARGETS[state.offset++];
+		output.data[0].SetValue(row, Value(target.name));
+		output.data[1].SetValue(row, Value::BOOLEAN(IsSupported(target.capability)));
+		output.data[2].SetValue(row, Value::BOOLEAN(IsAvailable(target.capability)));
+		output.data[3].SetValue(row, Value::BOOLEAN(state.selected == target.name));
+		row++;
+	}
+	output.SetCardinality(row);
+}
+
+//-------------------------------------------------------------------------
+// Register
+//-------------------------------------------------------------------------
+void HNSWModule::RegisterSimd(DatabaseInstance &db) {
+	db.config.AddExtensionOption(HNSWSimd::TARGET_SETTING,
+	                             "experimental: pin the distance kernels of the HNSW indexes of the database to an ISA level, "
+	                             "e.g. 'serial', 'haswell' ('avx2') or 'skylake' ('avx512'), or 'auto' to use the best "
+	                             "one available",
+	                             LogicalType::VARCHAR, Value("auto"), SetSimdTarget);
+
+	TableFunction capabilities_function("vss_simd_capabilities", {}, SimdCapabilitiesExecute, SimdCapabilitiesBind,
+	                                    SimdCapabilitiesInitGlobal);
+	ExtensionUtil::RegisterFunction(db, capabilities_function);
+}
+
+} // namespace duckdb
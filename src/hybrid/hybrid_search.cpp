@@ -0,0 +1,441 @@
+#include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/catalog/dependency_list.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/extension_util.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/planner/binder.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/storage/table/scan_state.hpp"
+#include "duckdb/transaction/duck_transaction.hpp"
+
+#include "hybrid/hybrid.hpp"
+#include "hnsw/hnsw_index.hpp"
+#include "sparse/sparse_index.hpp"
+
+namespace duckdb {
+
+enum class HybridFusion : uint8_t { RRF, WEIGHTED };
+
+//-------------------------------------------------------------------------
+// Bind
+//-------------------------------------------------------------------------
+struct HybridSearchBindData : public TableFunctionData {
+	HybridSearchBindData(DuckTableEntry &table, HNSWIndex &dense_index, SparseIndex &sparse_index)
+	    : table(table), dense_index(dense_index), sparse_index(sparse_index) {
+	}
+
+	//! The table to search
+	DuckTableEntry &table;
+	//! The indexes to search
+	HNSWIndex &dense_index;
+	SparseIndex &sparse_index;
+
+	//! The query vectors
+	unsafe_unique_array<float> dense_query;
+	sparse_vector_t sparse_query;
+
+	//! The number of results
+	idx_t limit = 10;
+	//! The number of candidates fetched from each index
+	idx_t candidates = 10;
+	//! How to combine the rankings of the two indexes
+	HybridFusion fusion = HybridFusion::RRF;
+	//! The rank offset of reciprocal rank fusion
+	idx_t rrf_k = 60;
+	//! The weight of the dense ranking, the sparse ranking gets the rest
+	double dense_weight = 0.5;
+
+	//! The storage ids of the columns to fetch
+	vector<storage_t> column_ids;
+
+public:
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<HybridSearchBindData>();
+		if (&other.table != &table || &other.dense_index != &dense_index || &other.sparse_index != &sparse_index ||
+		    other.sparse_query != sparse_query || other.limit != limit || other.candidates != candidates ||
+		    other.fusion != fusion || other.rrf_k != rrf_k || other.dense_weight != dense_weight ||
+		    other.column_ids != column_ids) {
+			return false;
+		}
+		auto vector_size = dense_index.GetVectorSize();
+		return memcmp(other.dense_query.get(), dense_query.get(), vector_size * sizeof(float)) == 0;
+	}
+};
+
+// Find an index of the given type on the table, by name if one is given
+template <class T>
+static T &FindIndex(ClientContext &context, DuckTableEntry &table, const string &index_name,
+                    const std::function<bool(T &)> &matches, const string &description) {
+	optional_ptr<T> result;
+	auto &table_info = *table.GetStorage().GetDataTableInfo();
+	table_info.GetIndexes().BindAndScan<T>(context, table_info, [&](T &index) {
+		if (index_name.empty() ? !matches(index) : index.GetIndexName() != index_name) {
+			return false;
+		}
+		result = &index;
+		return true;
+	});
+	if (!result) {
+		if (!index_name.empty()) {
+			throw BinderException("vss_hybrid_search: table '%s' has no %s index named '%s'", table.name,
+			                      T::TYPE_NAME, index_name);
+		}
+		throw BinderException("vss_hybrid_search: table '%s' has no %s index%s", table.name, T::TYPE_NAME,
+		                      description);
+	}
+	return *result;
+}
+
+static unique_ptr<FunctionData> HybridSearchBind(ClientContext &context, TableFunctionBindInput &input,
+                                                 vector<LogicalType> &return_types, vector<string> &names) {
+	for (auto &param : input.inputs) {
+		if (param.IsNull()) {
+			throw BinderException("vss_hybrid_search: arguments cannot be NULL");
+		}
+	}
+
+	// Look up the table
+	auto qname = QualifiedName::Parse(input.inputs[0].GetValue<string>());
+	Binder::BindSchemaOrCatalog(context, qname.catalog, qname.schema);
+	auto &table_entry = Catalog::GetEntry(context, CatalogType::TABLE_ENTRY, qname.catalog, qname.schema, qname.name)
+	                        .Cast<TableCatalogEntry>();
+	if (!table_entry.IsDuckTable()) {
+		throw BinderException("vss_hybrid_search: '%s' is not a DuckDB table", table_entry.name);
+	}
+	auto &table = table_entry.Cast<DuckTableEntry>();
+
+	// The dense query has to be a vector of floats
+	auto dense_value = input.inputs[1];
+	auto &dense_type = dense_value.type();
+	idx_t vector_size;
+	if (dense_type.id() == LogicalTypeId::ARRAY) {
+		vector_size = ArrayType::GetSize(dense_type);
+	} else if (dense_type.id() == LogicalTypeId::LIST) {
+		vector_size = ListValue::GetChildren(dense_value).size();
+	} else {
+		throw BinderException("vss_hybrid_search: the dense query must be of type FLOAT[N]");
+	}
+	if (!dense_value.DefaultTryCastAs(LogicalType::ARRAY(LogicalType::FLOAT, vector_size))) {
+		throw BinderException("vss_hybrid_search: the dense query must be of type FLOAT[N]");
+	}
+
+	// The sparse query has to be a map of weights
+	auto sparse_value = input.inputs[2];
+	if (!sparse_value.DefaultTryCastAs(LogicalType::MAP(LogicalType::INTEGER, LogicalType::FLOAT))) {
+		throw BinderException("vss_hybrid_search: the sparse query must be of type MAP(INTEGER, FLOAT)");
+	}
+
+	string dense_index_name;
+	string sparse_index_name;
+	int64_t limit = 10;
+	int64_t candidates = -1;
+	int64_t rrf_k = 60;
+	double dense_weight = 0.5;
+	auto fusion = HybridFusion::RRF;
+	for (auto &kv : input.named_parameters) {
+		if (kv.second.IsNull()) {
+			throw BinderException("vss_hybrid_search: '%s' cannot be NULL", kv.first);
+		}
+		if (kv.first == "k") {
+			limit = kv.second.GetValue<int64_t>();
+		} else if (kv.first == "candidates") {
+			candidates = kv.second.GetValue<int64_t>();
+		} else if (kv.first == "rrf_k") {
+			rrf_k = kv.second.GetValue<int64_t>();
+		} else if (kv.first == "dense_weight") {
+			dense_weight = kv.second.GetValue<double>();
+		} else if (kv.first == "fusion") {
+			auto fusion_name = kv.second.GetValue<string>();
+			if (StringUtil::CIEquals(fusion_name, "rrf")) {
+				fusion = HybridFusion::RRF;
+			} else if (StringUtil::CIEquals(fusion_name, "weighted")) {
+				fusion = HybridFusion::WEIGHTED;
+			} else {
+				throw BinderException("vss_hybrid_search: 'fusion' must be one of: 'rrf', 'weighted'");
+			}
+		} else if (kv.first == "dense_index") {
+			dense_index_name = kv.second.GetValue<string>();
+		} else if (kv.first == "sparse_index") {
+			sparse_index_name = kv.second.GetValue<string>();
+		}
+	}
+	if (limit < 1) {
+		throw BinderException("vss_hybrid_search: 'k' must be at least 1");
+	}
+	if (candidates == -1) {
+		candidates = limit;
+	} else if (candidates < 1) {
+		throw BinderException("vss_hybrid_search: 'candidates' must be at least 1");
+	}
+	if (rrf_k < 0) {
+		throw BinderException("vss_hybrid_search: 'rrf_k' must not be negative");
+	}
+	if (dense_weight < 0 || dense_weight > 1) {
+		throw BinderException("vss_hybrid_search: 'dense_weight' must be between 0 and 1");
+	}
+
+	// Find the indexes to search
+	auto &dense_index = FindIndex<HNSWIndex>(
+	    context, table, dense_index_name, [&](HNSWIndex &index) { return index.GetVectorSize() == vector_size; },
+	    StringUtil::Format(" over FLOAT[%llu] vectors", vector_size));
+	auto &sparse_index = FindIndex<SparseIndex>(
+	    context, table, sparse_index_name, [&](SparseIndex &index) { return true; }, "");
+	if (dense_index.GetVectorSize() != vector_size) {
+		throw BinderException("vss_hybrid_search: index '%s' is over FLOAT[%llu] vectors, not FLOAT[%llu]",
+		                      dense_index.GetIndexName(), dense_index.GetVectorSize(), vector_size);
+	}
+
+	// Pick up a vss_simd_target set since the index was last bound
+	dense_index.ApplySimdTarget();
+
+	auto result = make_uniq<HybridSearchBindData>(table, dense_index, sparse_index);
+	result->dense_query = make_unsafe_uniq_array<float>(vector_size);
+	auto dense_elements = ArrayValue::GetChildren(dense_value);
+	for (idx_t i = 0; i < vector_size; i++) {
+		result->dense_query[i] = dense_elements[i].GetValue<float>();
+	}
+	result->sparse_query = SparseIndex::GetSparseVector(sparse_value);
+	result->limit = static_cast<idx_t>(limit);
+	result->candidates = static_cast<idx_t>(candidates);
+	result->fusion = fusion;
+	result->rrf_k = static_cast<idx_t>(rrf_k);
+	result->dense_weight = dense_weight;
+
+	// Return all the columns of the table, followed by the fused score
+	for (auto &column : table.GetColumns().Physical()) {
+		names.push_back(column.Name());
+		return_types.push_back(column.Type());
+		result->column_ids.push_back(column.StorageOid());
+	}
+	names.emplace_back("score");
+	return_types.emplace_back(LogicalType::DOUBLE);
+
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Fusion
+//-------------------------------------------------------------------------
+
+// The results of one index, with the contribution of each rank to the fused score
+struct HybridRanking {
+	HybridRanking(const row_t *row_ids_p, idx_t count_p) : row_ids(row_ids_p), count(count_p) {
+		contributions.resize(count);
+		for (idx_t i = 0; i < count; i++) {
+			ranks[row_ids[i]] = i;
+		}
+	}
+
+	const row_t *row_ids;
+	idx_t count;
+	//! The contribution to the fused score by rank, ranks are ordered from best to worst so this does not increase
+	vector<double> contributions;
+	unordered_map<row_t, idx_t> ranks;
+
+	double Contribution(row_t row_id) const {
+		auto entry = ranks.find(row_id);
+		return entry == ranks.end() ? 0 : contributions[entry->second];
+	}
+	//! The largest contribution of any row at or below the given rank
+	double Bound(idx_t rank) const {
+		return rank < count ? contributions[rank] : 0;
+	}
+
+	void SetReciprocalRanks(double weight, idx_t rrf_k) {
+		for (idx_t i = 0; i < count; i++) {
+			contributions[i] = weight / static_cast<double>(rrf_k + i + 1);
+		}
+	}
+	//! Min-max normalize the scores of the results into [0, 1], where 1 is the best
+	void SetNormalizedScores(double weight, const float *scores) {
+		if (count == 0) {
+			return;
+		}
+		const auto best = static_cast<double>(scores[0]);
+		const auto worst = static_cast<double>(scores[count - 1]);
+		for (idx_t i = 0; i < count; i++) {
+			const auto normalized = best == worst ? 1 : (static_cast<double>(scores[i]) - worst) / (best - worst);
+			contributions[i] = weight * normalized;
+		}
+	}
+};
+
+// Combine the two rankings into the "limit" best rows. The rankings are consumed from the top down, and we stop as
+// soon as no row that has not been seen yet can beat the current results (Fagin's threshold algorithm).
+static vector<pair<double, row_t>> FuseRankings(const HybridRanking &dense, const HybridRanking &sparse, idx_t limit) {
+	vector<pair<double, row_t>> top;
+	const auto heap_compare = std::greater<pair<double, row_t>>();
+	unordered_set<row_t> seen;
+
+	const auto depth = MaxValue(dense.count, sparse.count);
+	for (idx_t rank = 0; rank < depth; rank++) {
+		for (auto ranking : {&dense, &sparse}) {
+			if (rank >= ranking->count) {
+				continue;
+			}
+			auto row_id = ranking->row_ids[rank];
+			if (!seen.insert(row_id).second) {
+				continue;
+			}
+			auto score = dense.Contribution(row_id) + sparse.Contribution(row_id);
+			if (top.size() < limit) {
+				top.emplace_back(score, row_id);
+				std::push_heap(top.begin(), top.end(), heap_compare);
+			} else if (score > top.front().first) {
+				std::pop_heap(top.begin(), top.end(), heap_compare);
+				top.back() = make_pair(score, row_id);
+				std::push_heap(top.begin(), top.end(), heap_compare);
+			}
+		}
+
+		// The best score any row that has not been seen yet can reach
+		auto bound = dense.Bound(rank + 1) + sparse.Bound(rank + 1);
+		if (top.size() == limit && top.front().first >= bound) {
+			break;
+		}
+	}
+
+	// Order the results by descending score
+	std::sort_heap(top.begin(), top.end(), heap_compare);
+	return top;
+}
+
+//-------------------------------------------------------------------------
+// Global State
+//-------------------------------------------------------------------------
+struct HybridSearchGlobalState : public GlobalTableFunctionState {
+	//! The fused results, ordered by descending score
+	vector<pair<double, row_t>> results;
+	unordered_map<row_t, double> scores;
+	idx_t offset = 0;
+
+	vector<storage_t> fetch_ids;
+	DataChunk fetch_chunk;
+	ColumnFetchState fetch_state;
+	Vector row_ids = Vector(LogicalType::ROW_TYPE);
+};
+
+static unique_ptr<GlobalTableFunctionState> HybridSearchInitGlobal(ClientContext &context,
+                                                                   TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<HybridSearchBindData>();
+	auto result = make_uniq<HybridSearchGlobalState>();
+
+	// Search the dense index
+	auto &dense_index = bind_data.dense_index;
+	auto dense_state = dense_index.InitializeScan(bind_data.table, bind_data.dense_query.get(), bind_data.candidates,
+	                                             context);
+	// Re-rank the candidates with the full vectors if the index only covers some of the dimensions
+	dense_index.RefineScan(*dense_state, bind_data.table, context, bind_data.dense_query.get(), bind_data.candidates);
+	auto &dense_result = dense_state->Cast<HNSWIndexScanState>();
+
+	// Search the sparse index
+	auto sparse_state = bind_data.sparse_index.InitializeScan(bind_data.sparse_query, bind_data.candidates);
+	auto &sparse_result = sparse_state->Cast<SparseIndexScanState>();
+
+	// Fuse the two rankings
+	HybridRanking dense(dense_result.row_ids.get(), dense_result.total_rows);
+	HybridRanking sparse(sparse_result.row_ids.get(), sparse_result.total_rows);
+	const auto sparse_weight = 1 - bind_data.dense_weight;
+	if (bind_data.fusion == HybridFusion::RRF) {
+		dense.SetReciprocalRanks(bind_data.dense_weight, bind_data.rrf_k);
+		sparse.SetReciprocalRanks(sparse_weight, bind_data.rrf_k);
+	} else {
+		// Distances are better the smaller they are, so negate them to normalize like scores
+		auto dense_scores = make_unsafe_uniq_array<float>(dense.count);
+		for (idx_t i = 0; i < dense.count; i++) {
+			dense_scores[i] = -dense_result.distances[i];
+		}
+		dense.SetNormalizedScores(bind_data.dense_weight, dense_scores.get());
+		sparse.SetNormalizedScores(sparse_weight, sparse_result.scores.get());
+	}
+	result->results = FuseRankings(dense, sparse, bind_data.limit);
+	for (auto &entry : result->results) {
+		result->scores[entry.second] = entry.first;
+	}
+
+	// Fetch the columns of the table together with the row ids, which are used to look up the scores of the rows
+	// that are visible to us
+	result->fetch_ids = bind_data.column_ids;
+	result->fetch_ids.push_back(COLUMN_IDENTIFIER);
+	auto fetch_types = bind_data.table.GetTypes();
+	fetch_types.push_back(LogicalType::ROW_TYPE);
+	result->fetch_chunk.Initialize(context, fetch_types);
+
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Execute
+//-------------------------------------------------------------------------
+static void HybridSearchExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<HybridSearchBindData>();
+	auto &state = data_p.global_state->Cast<HybridSearchGlobalState>();
+	auto &transaction = DuckTransaction::Get(context, bind_data.table.catalog);
+	auto &storage = bind_data.table.GetStorage();
+
+	auto row_id_data = FlatVector::GetData<row_t>(state.row_ids);
+	while (state.offset < state.results.size()) {
+		const auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, state.results.size() - state.offset);
+		for (idx_t i = 0; i < count; i++) {
+			row_id_data[i] = state.results[state.offset + i].second;
+		}
+		state.offset += count;
+
+		// Rows that are not visible to us are skipped by the fetch
+		state.fetch_chunk.Reset();
+		storage.Fetch(transaction, state.fetch_chunk, state.fetch_ids, state.row_ids, count, state.fetch_state);
+		if (state.fetch_chunk.size() == 0) {
+			continue;
+		}
+
+		const auto column_count = bind_data.column_ids.size();
+		for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+			output.data[col_idx].Reference(state.fetch_chunk.data[col_idx]);
+		}
+		auto fetched_row_ids = FlatVector::GetData<row_t>(state.fetch_chunk.data[column_count]);
+		auto score_data = FlatVector::GetData<double>(output.data[column_count]);
+		for (idx_t i = 0; i < state.fetch_chunk.size(); i++) {
+			score_data[i] = state.scores[fetched_row_ids[i]];
+		}
+		output.SetCardinality(state.fetch_chunk.size());
+		return;
+	}
+	output.SetCardinality(0);
+}
+
+//-------------------------------------------------------------------------
+// Dependency
+//-------------------------------------------------------------------------
+static void HybridSearchDependency(LogicalDependencyList &entries, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<HybridSearchBindData>();
+	entries.AddDependency(bind_data.table);
+}
+
+//-------------------------------------------------------------------------
+// Cardinality
+//-------------------------------------------------------------------------
+static unique_ptr<NodeStatistics> HybridSearchCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<HybridSearchBindData>();
+	return make_uniq<NodeStatistics>(bind_data.limit, bind_data.limit);
+}
+
+//-------------------------------------------------------------------------
+// Register
+//-------------------------------------------------------------------------
+void HybridModule::RegisterHybridSearch(DatabaseInstance &db) {
+	TableFunction func("vss_hybrid_search", {LogicalType::VARCHAR, LogicalType::ANY, LogicalType::ANY},
+	                   HybridSearchExecute, HybridSearchBind, HybridSearchInitGlobal);
+	func.named_parameters["k"] = LogicalType::BIGINT;
+	func.named_parameters["candidates"] = LogicalType::BIGINT;
+	func.named_parameters["fusion"] = LogicalType::VARCHAR;
+	func.named_parameters["rrf_k"] = LogicalType::BIGINT;
+	func.named_parameters["dense_weight"] = LogicalType::DOUBLE;
+	func.named_parameters["dense_index"] = LogicalType::VARCHAR;
+	func.named_parameters["sparse_index"] = LogicalType::VARCHAR;
+	func.dependency = HybridSearchDependency;
+	func.cardinality = HybridSearchCardinality;
+	ExtensionUtil::RegisterFunction(db, func);
+}
+
+} // namespace duckdb
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "duckdb/execution/index/fixed_size_allocator.hpp"
+#include "duckdb/execution/index/index_pointer.hpp"
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// Linked Blocks
+//------------------------------------------------------------------------------
+
+class LinkedBlock {
+public:
+	static constexpr const idx_t BLOCK_SIZE = Storage::BLOCK_SIZE - sizeof(validity_t);
+	static constexpr const idx_t BLOCK_DATA_SIZE = BLOCK_SIZE - sizeof(IndexPointer);
+	static_assert(BLOCK_SIZE > sizeof(IndexPointer), "Block size must be larger than the size of an IndexPointer");
+
+	IndexPointer next_block;
+	char data[BLOCK_DATA_SIZE] = {0};
+};
+
+class LinkedBlockReader {
+private:
+	FixedSizeAllocator &allocator;
+
+	IndexPointer root_pointer;
+	IndexPointer current_pointer;
+	idx_t position_in_block;
+
+public:
+	LinkedBlockReader(FixedSizeAllocator &allocator, IndexPointer root_pointer)
+	    : allocator(allocator), root_pointer(root_pointer), current_pointer(root_pointer), position_in_block(0) {
+	}
+
+	void Reset();
+	idx_t ReadData(data_ptr_t buffer, idx_t length);
+	//! Hash the contents of all blocks in the chain, without copying them out
+	hash_t HashBlocks();
+};
+
+class LinkedBlockWriter {
+private:
+	FixedSizeAllocator &allocator;
+
+	IndexPointer root_pointer;
+	IndexPointer current_pointer;
+	idx_t position_in_block;
+
+public:
+	LinkedBlockWriter(FixedSizeAllocator &allocator, IndexPointer root_pointer)
+	    : allocator(allocator), root_pointer(root_pointer), current_pointer(root_pointer), position_in_block(0) {
+	}
+
+	void ClearCurrentBlock();
+	void Reset();
+	void WriteData(const_data_ptr_t buffer, idx_t length);
+};
+
+} // namespace duckdb
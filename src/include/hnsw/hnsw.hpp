@@ -10,16 +10,20 @@ public:
 		RegisterIndex(db);
 		RegisterIndexScan(db);
 		RegisterIndexPragmas(db);
+		RegisterSearch(db);
 		RegisterPlanIndexScan(db);
 		RegisterPlanIndexCreate(db);
+		RegisterSimd(db);
 	}
 
 private:
 	static void RegisterIndex(DatabaseInstance &db);
 	static void RegisterIndexScan(DatabaseInstance &db);
 	static void RegisterIndexPragmas(DatabaseInstance &db);
+	static void RegisterSearch(DatabaseInstance &db);
 	static void RegisterPlanIndexScan(DatabaseInstance &db);
 	static void RegisterPlanIndexCreate(DatabaseInstance &db);
+	static void RegisterSimd(DatabaseInstance &db);
 };
 
 } // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+
+namespace duckdb {
+
+class RandomEngine;
+
+//! The order in which the vectors are inserted into the graph when an index is created. Inserting vectors in the
+//! order they were ingested in, e.g. sorted by time or category, builds the graph one region at a time, which
+//! hurts its quality and makes the threads contend for the nodes of the same region.
+class HNSWBuildOrder {
+public:
+	//! Insert the vectors in the order they are scanned from the table
+	static constexpr const char *SCAN = "scan";
+	//! Insert the vectors in a random order
+	static constexpr const char *SHUFFLE = "shuffle";
+	//! Interleave the clusters found by a coarse k-means pass, visiting every cluster at the same rate
+	static constexpr const char *CLUSTER = "cluster";
+
+	//! The supported build orders
+	static const case_insensitive_set_t KINDS;
+
+	//! The maximum number of clusters of the k-means pass, one per this many vectors
+	static constexpr const idx_t MAX_CLUSTERS = 64;
+	static constexpr const idx_t VECTORS_PER_CLUSTER = 1024;
+	//! The number of vectors per cluster sampled to train the k-means pass on
+	static constexpr const idx_t SAMPLE_PER_CLUSTER = 64;
+	//! The number of k-means iterations
+	static constexpr const idx_t KMEANS_ITERATIONS = 8;
+
+public:
+	//! Get the order to insert "count" vectors in, as the position of every vector in "vectors"
+	static vector<idx_t> Shuffle(idx_t count, RandomEngine &engine);
+	//! Get the cluster-interleaved order of "count" vectors of "dims" dimensions, stored back to back in "vectors"
+	static vector<idx_t> ClusterInterleave(const float *vectors, idx_t count, idx_t dims, RandomEngine &engine);
+	//! Draw the HNSW level of every vector in "order" for a graph of the given connectivity, and move the vectors that
+	//! reach past the base level to the front, keeping their relative order. Their levels are stored in "levels".
+	//! Returns the number of such vectors.
+	static idx_t PartitionUpperLevels(vector<idx_t> &order, vector<int32_t> &levels, double connectivity,
+	                                  RandomEngine &engine);
+};
+
+} // namespace duckdb
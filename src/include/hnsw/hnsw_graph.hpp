@@ -0,0 +1,263 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/common/unique_ptr.hpp"
+
+#include "usearch/duckdb_usearch.hpp"
+
+namespace duckdb {
+
+//! The usearch graph of an HNSW index, with either 32-bit or 40-bit slots. The slots address the nodes of the graph,
+//! and make up the neighbour lists, so 32-bit slots keep the graph small while 40-bit slots lift the limit of ~4B
+//! vectors. The width is picked when the graph is created, and mirrors the interface of index_dense_gt otherwise.
+class HNSWGraph {
+public:
+	using narrow_index_t = unum::usearch::index_dense_gt<row_t, uint32_t>;
+	using wide_index_t = unum::usearch::index_dense_gt<row_t, unum::usearch::uint40_t>;
+	using stats_t = narrow_index_t::stats_t;
+
+	//! The number of bytes per slot of a graph with narrow or wide slots
+	static constexpr const idx_t NARROW_SLOT_BYTES = 4;
+	static constexpr const idx_t WIDE_SLOT_BYTES = 5;
+	//! The most vectors a graph with narrow slots can hold, the largest slot is reserved by usearch
+	static constexpr const idx_t MAX_NARROW_SIZE = std::numeric_limits<uint32_t>::max() - 1;
+
+	//! The results of a search, ordered by distance
+	struct search_result_t {
+		idx_t count = 0;
+		unique_array<row_t> keys;
+		unique_array<float> distances;
+	};
+
+public:
+	void initialize(const unum::usearch::metric_punned_t &metric, const unum::usearch::index_dense_config_t &config,
+	                bool wide) {
+		is_wide_ = wide;
+		if (wide) {
+			wide_ = wide_index_t::make(metric, config);
+		} else {
+			narrow_ = narrow_index_t::make(metric, config);
+		}
+	}
+
+	//! Switch an empty graph with narrow slots to wide slots
+	void widen() {
+		D_ASSERT(!is_wide_ && narrow_.size() == 0);
+		auto metric = narrow_.metric();
+		auto config = narrow_.config();
+		narrow_ = narrow_index_t();
+		initialize(metric, config, true);
+	}
+
+	bool is_wide() const {
+		return is_wide_;
+	}
+	idx_t slot_bytes() const {
+		return is_wide_ ? WIDE_SLOT_BYTES : NARROW_SLOT_BYTES;
+	}
+	//! The most vectors the graph can hold
+	idx_t max_size() const {
+		return is_wide_ ? NumericLimits<idx_t>::Maximum() : MAX_NARROW_SIZE;
+	}
+
+	std::size_t size() const {
+		return is_wide_ ? wide_.size() : narrow_.size();
+	}
+	std::size_t capacity() const {
+		return is_wide_ ? wide_.capacity() : narrow_.capacity();
+	}
+	std::size_t max_level() const {
+		return is_wide_ ? wide_.max_level() : narrow_.max_level();
+	}
+	std::size_t dimensions() const {
+		return is_wide_ ? wide_.dimensions() : narrow_.dimensions();
+	}
+	std::size_t expansion_search() const {
+		return is_wide_ ? wide_.expansion_search() : narrow_.expansion_search();
+	}
+	void change_expansion_search(std::size_t n) {
+		if (is_wide_) {
+			wide_.change_expansion_search(n);
+		} else {
+			narrow_.change_expansion_search(n);
+		}
+	}
+	std::size_t bytes_per_vector() const {
+		return is_wide_ ? wide_.bytes_per_vector() : narrow_.bytes_per_vector();
+	}
+	std::size_t memory_usage() const {
+		return is_wide_ ? wide_.memory_usage() : narrow_.memory_usage();
+	}
+	unum::usearch::huge_pages_t huge_pages_backing() const {
+		return is_wide_ ? wide_.huge_pages_backing() : narrow_.huge_pages_backing();
+	}
+	const unum::usearch::index_dense_config_t &config() const {
+		return is_wide_ ? wide_.config() : narrow_.config();
+	}
+	const unum::usearch::metric_punned_t &metric() const {
+		return is_wide_ ? wide_.metric() : narrow_.metric();
+	}
+	void change_metric(unum::usearch::metric_punned_t metric) {
+		if (is_wide_) {
+			wide_.change_metric(std::move(metric));
+		} else {
+			narrow_.change_metric(std::move(metric));
+		}
+	}
+	stats_t stats(std::size_t level) const {
+		if (!is_wide_) {
+			return narrow_.stats(level);
+		}
+		auto wide_stats = wide_.stats(level);
+		stats_t result;
+		result.nodes = wide_stats.nodes;
+		result.edges = wide_stats.edges;
+		result.max_edges = wide_stats.max_edges;
+		result.allocated_bytes = wide_stats.allocated_bytes;
+		return result;
+	}
+
+	bool reserve(unum::usearch::index_limits_t limits) {
+		return is_wide_ ? wide_.reserve(limits) : narrow_.reserve(limits);
+	}
+	void reset() {
+		if (is_wide_) {
+			wide_.reset();
+		} else {
+			narrow_.reset();
+		}
+	}
+
+	unum::usearch::error_t add(row_t key, const float *vector, std::size_t thread, bool force_vector_copy = true,
+	                           int32_t level = -1) {
+		if (is_wide_) {
+			return std::move(wide_.add(key, vector, thread, force_vector_copy, level).error);
+		}
+		return std::move(narrow_.add(key, vector, thread, force_vector_copy, level).error);
+	}
+	unum::usearch::error_t remove(row_t key) {
+		if (is_wide_) {
+			return std::move(wide_.remove(key).error);
+		}
+		return std::move(narrow_.remove(key).error);
+	}
+
+	search_result_t ef_search(const float *query, std::size_t wanted, std::size_t ef_search) const {
+		if (is_wide_) {
+			return ToSearchResult(wide_.ef_search(query, wanted, ef_search));
+		}
+		return ToSearchResult(narrow_.ef_search(query, wanted, ef_search));
+	}
+	//! Search for the closest vectors whose key satisfies the predicate, vectors that don't are still traversed
+	template <typename predicate_at>
+	search_result_t filtered_ef_search(const float *query, std::size_t wanted, std::size_t ef_search,
+	                                   predicate_at &&predicate) const {
+		if (is_wide_) {
+			return ToSearchResult(wide_.filtered_ef_search(query, wanted, ef_search, predicate));
+		}
+		return ToSearchResult(narrow_.filtered_ef_search(query, wanted, ef_search, predicate));
+	}
+
+	//! Copy the vector stored for "key" into "vector", returns false if the graph has no vector for it
+	bool get(row_t key, float *vector) const {
+		return is_wide_ ? wide_.get(key, vector) != 0 : narrow_.get(key, vector) != 0;
+	}
+
+	//! The keys of the vectors in the graph, without the removed ones
+	vector<row_t> keys() const {
+		return is_wide_ ? Keys(wide_) : Keys(narrow_);
+	}
+
+	std::size_t warmup(std::size_t queries) const {
+		return is_wide_ ? wide_.warmup(queries) : narrow_.warmup(queries);
+	}
+
+	template <typename progress_at>
+	unum::usearch::error_t compact(progress_at &&progress) {
+		if (is_wide_) {
+			return std::move(
+			    wide_.compact(unum::usearch::dummy_executor_t {}, std::forward<progress_at>(progress)).error);
+		}
+		return std::move(
+		    narrow_.compact(unum::usearch::dummy_executor_t {}, std::forward<progress_at>(progress)).error);
+	}
+
+	//! Replace "other" with a deep copy of this graph
+	unum::usearch::error_t copy_to(HNSWGraph &other) const {
+		other.is_wide_ = is_wide_;
+		if (is_wide_) {
+			auto result = wide_.copy();
+			if (result) {
+				other.wide_ = std::move(result.index);
+			}
+			return std::move(result.error);
+		}
+		auto result = narrow_.copy();
+		if (result) {
+			other.narrow_ = std::move(result.index);
+		}
+		return std::move(result.error);
+	}
+	//! Replace the key of every vector in the graph
+	template <typename transform_at>
+	unum::usearch::error_t transform_keys(transform_at &&transform) {
+		if (is_wide_) {
+			return wide_.transform_keys(std::forward<transform_at>(transform));
+		}
+		return narrow_.transform_keys(std::forward<transform_at>(transform));
+	}
+
+	template <typename output_callback_at>
+	unum::usearch::serialization_result_t
+	save_to_stream(output_callback_at &&output, unum::usearch::index_dense_serialization_config_t config = {}) const {
+		if (is_wide_) {
+			return wide_.save_to_stream(std::forward<output_callback_at>(output), config);
+		}
+		return narrow_.save_to_stream(std::forward<output_callback_at>(output), config);
+	}
+	template <typename input_callback_at>
+	unum::usearch::serialization_result_t load_from_stream(input_callback_at &&input) {
+		if (is_wide_) {
+			return wide_.load_from_stream(std::forward<input_callback_at>(input));
+		}
+		return narrow_.load_from_stream(std::forward<input_callback_at>(input));
+	}
+	//! Map the graph from a file saved in the raw format, rather than loading it into memory
+	unum::usearch::serialization_result_t view(unum::usearch::memory_mapped_file_t file) {
+		return is_wide_ ? wide_.view(std::move(file)) : narrow_.view(std::move(file));
+	}
+	std::size_t serialized_length() const {
+		return is_wide_ ? wide_.serialized_length() : narrow_.serialized_length();
+	}
+
+private:
+	template <class RESULT>
+	static search_result_t ToSearchResult(RESULT &&result) {
+		search_result_t search_result;
+		search_result.count = result.size();
+		search_result.keys = make_uniq_array<row_t>(search_result.count);
+		search_result.distances = make_uniq_array<float>(search_result.count);
+		result.dump_to(search_result.keys.get(), search_result.distances.get());
+		return search_result;
+	}
+
+	template <class INDEX>
+	static vector<row_t> Keys(const INDEX &index) {
+		vector<row_t> result;
+		result.reserve(index.size());
+		for (auto it = index.cbegin(); it != index.cend(); ++it) {
+			auto key = get_key(it);
+			if (key != index.free_key()) {
+				result.push_back(key);
+			}
+		}
+		return result;
+	}
+
+	bool is_wide_ = false;
+	narrow_index_t narrow_;
+	wide_index_t wide_;
+};
+
+} // namespace duckdb
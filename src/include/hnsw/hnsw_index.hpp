@@ -5,20 +5,98 @@
 #include "duckdb/execution/index/fixed_size_allocator.hpp"
 #include "duckdb/common/array.hpp"
 #include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/optional_idx.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/unordered_set.hpp"
 
+#include "hnsw/hnsw_graph.hpp"
+#include "hnsw/hnsw_projection.hpp"
 #include "usearch/duckdb_usearch.hpp"
 
 namespace duckdb {
 
 class StorageLock;
+class StorageLockKey;
+class DuckTableEntry;
+class IndexCatalogEntry;
+class LinkedBlockReader;
+class FileHandle;
+class DataTable;
+
+//! How often the index lock was acquired, and how long threads waited for it in total
+struct HNSWLockStats {
+	idx_t shared_acquisitions = 0;
+	idx_t shared_wait_us = 0;
+	idx_t exclusive_acquisitions = 0;
+	idx_t exclusive_wait_us = 0;
+};
+
+//! The progress of a running compaction, in steps of the compaction of a single node
+struct HNSWCompactionProgress {
+	atomic<idx_t> processed = {0};
+	atomic<idx_t> total = {0};
+};
 
 struct HNSWIndexStats {
 	idx_t max_level;
 	idx_t count;
 	idx_t capacity;
 	idx_t approx_size;
-	vector<unum::usearch::index_dense_gt<row_t>::stats_t> level_stats;
+	vector<HNSWGraph::stats_t> level_stats;
+	HNSWLockStats lock_stats;
+	//! The ISA level of the distance kernels of the graph
+	string isa;
+	//! The number of bytes per slot of the graph
+	idx_t slot_bytes;
+	//! The default ef_search of the graph
+	idx_t ef_search;
+	//! The kind of pages the graph is actually backed with, which can fall short of its huge_pages option
+	string huge_pages;
+	//! The number of times the graph was warmed up
+	idx_t warmups;
+};
+
+//! The rows appended to and deleted from an index while it is being rebuilt, which the rebuilt graph has to catch
+//! up on before it replaces the current one
+struct HNSWRebuildLog {
+	//! The appended vectors and their row ids
+	unique_ptr<ColumnDataCollection> appends;
+	//! The row ids of the deleted rows
+	vector<row_t> deletes;
+};
+
+//! The estimated cost and recall of a scan, used to choose between several indexes that could serve a query
+struct HNSWScanEstimate {
+	//! The number of bytes of vector data compared with the query, including refinement
+	double cost = 0;
+	//! A proxy for the recall: the number of neighbours compared on the base level, scaled down by the fraction of
+	//! the dimensions the graph is searched on
+	double quality = 0;
+};
+
+// Scan State
+struct HNSWIndexScanState : public IndexScanState {
+	idx_t current_row = 0;
+	idx_t total_rows = 0;
+	//! The row ids of the results, ordered by distance
+	unique_array<row_t> row_ids = nullptr;
+	//! The distance of each result to the query vector
+	unique_array<float> distances = nullptr;
+	//! Whether the results are candidates that still need to be re-ranked with the full vectors
+	bool requires_refinement = false;
+
+	//! The ef_search of the scan, if it overrides the default of the index
+	optional_idx ef_search;
+	//! How many more candidates than requested are searched for if the graph needs refinement
+	idx_t refine_factor = 1;
+	//! The number of candidates the last search asked the graph for
+	idx_t search_limit = 0;
+	//! The number of times the graph was searched
+	idx_t searches = 0;
+	//! The rows found so far that are not visible to the transaction of the scan, which further searches skip
+	unordered_set<row_t> invisible;
 };
 
 class HNSWIndex : public BoundIndex {
@@ -33,7 +111,7 @@ public:
 	          const IndexStorageInfo &info = IndexStorageInfo(), idx_t estimated_cardinality = 0);
 
 	//! The actual usearch index
-	unum::usearch::index_dense_gt<row_t> index;
+	HNSWGraph index;
 
 	//! Block pointer to the root of the index
 	IndexPointer root_block_ptr;
@@ -41,22 +119,101 @@ public:
 	//! The allocator used to persist linked blocks
 	unique_ptr<FixedSizeAllocator> linked_block_allocator;
 
-	unique_ptr<IndexScanState> InitializeScan(float *query_vector, idx_t limit, ClientContext &context);
+	//! Search the graph for the "limit" closest vectors among the rows of "table" visible to the transaction of the
+	//! client. "ef_search" overrides both the hnsw_ef_search setting and the default of the index for this search
+	unique_ptr<IndexScanState> InitializeScan(DuckTableEntry &table, float *query_vector, idx_t limit,
+	                                          ClientContext &context, optional_idx ef_search = optional_idx());
+	//! Find the "limit" closest vectors by comparing the query with every visible row of the table, without the graph
+	unique_ptr<IndexScanState> InitializeExactScan(DuckTableEntry &table, ClientContext &context,
+	                                               const float *query_vector, idx_t limit);
+	//! Change the default ef_search of the graph, which searches use unless it is overridden
+	void SetSearchExpansion(idx_t ef_search);
+	//! How many more candidates than requested a scan that needs refinement fetches from the graph
+	static idx_t GetRefineFactor(ClientContext &context);
+	//! Estimate the cost and recall of a scan for the "limit" closest vectors with the settings of the client
+	HNSWScanEstimate EstimateScan(idx_t limit, ClientContext &context);
+	//! Switch the distance kernels of the graph to the vss_simd_target of the database, if it changed. This happens when
+	//! the index is loaded, and when a query binds it
+	void ApplySimdTarget();
 	idx_t Scan(IndexScanState &state, Vector &result);
+	//! Re-rank the candidates of a scan using the full vectors fetched from the table, keeping the closest "limit".
+	//! Does nothing if the graph the scan searched did not need refinement.
+	void RefineScan(IndexScanState &state, DuckTableEntry &table, ClientContext &context, const float *query_vector,
+	                idx_t limit);
 
 	idx_t GetVectorSize() const;
+	//! The number of leading dimensions the graph is built and searched on
+	idx_t GetSearchDimensions() const;
+	//! Whether vectors are projected into a lower-dimensional space before being added to or searched in the graph
+	bool HasProjection() const;
+	//! Project a vector into the space of the graph, "result" must hold GetSearchDimensions() elements
+	void ProjectVector(const float *vec, float *result) const;
+	//! Learn the projection from a sample of the indexed vectors, if the index is configured to use PCA
+	void LearnProjection(const float *sample, idx_t count);
 	static bool IsDistanceFunction(const string &distance_function_name);
 	bool MatchesDistanceFunction(const string &distance_function_name) const;
+	//! Whether the index is over "expr", in which the columns of the table are referenced by their storage index
+	bool MatchesExpression(const Expression &expr) const;
 	string GetMetric() const;
 
-	void Construct(DataChunk &input, Vector &row_ids, idx_t thread_idx);
+	//! Add vectors to the graph, growing it as needed. The graph is not grown beyond "max_capacity" vectors ahead of
+	//! time, so that a build within a memory budget does not reserve more than the budget allows.
+	void Construct(DataChunk &input, Vector &row_ids, idx_t thread_idx,
+	               idx_t max_capacity = DConstants::INVALID_INDEX);
 	void PersistToDisk();
-	void Compact();
+	//! Compact the index, reporting the progress as it goes. Throws if the client is interrupted, in which case
+	//! the index is left as it was
+	void Compact(ClientContext &context, HNSWCompactionProgress &progress);
+
+	//! Rebuild the graph with new options in a shadow index, from the rows of "storage". Searches keep using the
+	//! current graph until the new one has caught up on the rows appended and deleted in the meantime and replaces it
+	void Rebuild(ClientContext &context, DataTable &storage, const case_insensitive_map_t<Value> &options);
+
+	//! Read the options of the catalog entry of the index, which rebuilds and alters replace in place
+	case_insensitive_map_t<Value> GetEntryOptions(IndexCatalogEntry &entry);
+	//! Replace the options of the catalog entry of the index. The transaction of the client has to be marked as
+	//! modifying the database of the index, which keeps checkpoints, which write the options out, from running
+	//! until it ends
+	void SetEntryOptions(IndexCatalogEntry &entry, case_insensitive_map_t<Value> options);
+
+	//! Pull the upper levels of the graph into memory and the caches, and run "queries" searches for indexed vectors
+	//! to warm up the paths searches take. Returns the number of nodes in the upper levels
+	idx_t Warmup(idx_t queries);
 
 	unique_ptr<HNSWIndexStats> GetStats();
 
+	//! Write the graph to a standalone file, in the usearch format followed by the projection if any
+	void Export(ClientContext &context, const string &path);
+	//! Replace the graph with one exported to a file, verifying that it was built with the same parameters
+	void Import(ClientContext &context, const string &path);
+	//! The number of bytes per slot of the graph in an exported file
+	static idx_t ReadFileSlotBytes(ClientContext &context, const string &path);
+	//! Replace the graph with a copy of the graph of another index, which must have been created with the same options
+	void CopyFrom(HNSWIndex &source);
+	//! Replace the row ids the graph refers to, mapping each row id in the sorted "old_row_ids" to the row id at the
+	//! same position in the sorted "new_row_ids"
+	void RemapRowIds(const vector<row_t> &old_row_ids, const vector<row_t> &new_row_ids);
+	//! Compare the vectors of "count" rows, stored one after another, with the vectors the graph holds for their row
+	//! ids, after projecting them into the space of the graph. Returns the position of the first row whose vector is
+	//! missing or differs, if any
+	optional_idx FindMismatchedVector(const float *vectors, const row_t *row_ids, idx_t count);
+
+	//! Verify the options of an index over keys of "key_type", throwing a BinderException for invalid ones
+	static void VerifyOptions(const case_insensitive_map_t<Value> &options, const LogicalType &key_type,
+	                          bool is_column_ref);
+
 	static const case_insensitive_map_t<unum::usearch::metric_kind_t> METRIC_KIND_MAP;
 	static const unordered_map<uint8_t, unum::usearch::scalar_kind_t> SCALAR_KIND_MAP;
+	static const case_insensitive_map_t<unum::usearch::huge_pages_t> HUGE_PAGES_MAP;
+
+	//! The default number of candidates to fetch per result row when refining scans
+	static constexpr const idx_t DEFAULT_REFINE_FACTOR = 4;
+	//! The default number of sample searches run when warming up an index
+	static constexpr const idx_t DEFAULT_WARMUP_QUERIES = 256;
+	//! The setting to warm up indexes as soon as they are loaded from disk
+	static constexpr const char *WARMUP_ON_LOAD_SETTING = "hnsw_warmup_on_load";
+	//! The setting for the directory to share memory-mapped copies of the indexes of read-only databases in
+	static constexpr const char *MMAP_DIRECTORY_SETTING = "hnsw_mmap_directory";
 
 public:
 	//! Called when data is appended to the index. The lock obtained from InitializeLock must be held
@@ -74,6 +231,10 @@ public:
 
 	IndexStorageInfo GetStorageInfo(const bool get_buffers) override;
 	idx_t GetInMemorySize(IndexLock &state) override;
+	//! Estimate the memory used by the graph once it holds "count" vectors, without building it
+	idx_t EstimateMemoryUsage(idx_t count) const;
+	//! Estimate the number of vectors the graph can hold within "memory" bytes, the inverse of EstimateMemoryUsage
+	idx_t EstimateCapacity(idx_t memory) const;
 
 	//! Merge another index into this index. The lock obtained from InitializeLock must be held, and the other
 	//! index must also be locked during the merge
@@ -101,9 +262,73 @@ public:
 	}
 
 private:
+	//! The number of dimensions of the indexed vectors
+	idx_t vector_size;
+	//! The metric over all dimensions of the indexed vectors, used to refine scans
+	unum::usearch::metric_punned_t refine_metric;
+	//! Whether scans need to be refined with the full vectors
+	bool requires_refinement;
+	//! The projection applied to vectors before they reach the graph, if any
+	unique_ptr<HNSWProjection> projection;
+	//! Whether the projection should be learned from the data (PCA) rather than drawn at random
+	bool learn_projection = false;
+
+	//! Whether the neighbour lists are delta-coded and bit-packed when the index is written to disk
+	bool compress_neighbors = false;
+
+	//! The file the graph is memory-mapped from, if the index is shared between processes
+	string mapped_path;
+	//! Load the graph, and the projection stored after it, from the linked blocks of the index
+	void Deserialize(LinkedBlockReader &reader);
+	//! Write the graph, and the projection after it, to a file
+	void WriteToFile(FileHandle &handle);
+	//! Map the graph from a copy in "directory" shared by all processes attaching this version of the database,
+	//! creating the copy if needed
+	void MapFromDirectory(AttachedDatabase &db, const string &directory);
+
+	//! The log of the running rebuild, if any. Guarded by "rebuild_lock", which appends and deletes hold throughout,
+	//! so that the rebuilt graph never misses or repeats one of them
+	mutex rebuild_lock;
+	unique_ptr<HNSWRebuildLog> rebuild_log;
+
+	//! Guards the options of the catalog entry of the index, see GetEntryOptions
+	mutex entry_options_lock;
+	//! Apply the changes in a rebuild log to the graph
+	void ApplyRebuildLog(HNSWRebuildLog &log);
+
 	bool is_dirty = false;
 	StorageLock rwlock;
 	atomic<idx_t> index_size = {0};
+
+	//! Acquire the index lock, keeping track of the time spent waiting for it
+	unique_ptr<StorageLockKey> GetSharedLock();
+	unique_ptr<StorageLockKey> GetExclusiveLock();
+	atomic<idx_t> shared_lock_acquisitions = {0};
+	atomic<idx_t> shared_lock_wait_ns = {0};
+	atomic<idx_t> exclusive_lock_acquisitions = {0};
+	atomic<idx_t> exclusive_lock_wait_ns = {0};
+	//! The number of times the graph was warmed up, on load or with hnsw_warmup
+	atomic<idx_t> warmups = {0};
+
+	//! The SIMD capabilities the distance kernels of the graph are restricted to
+	atomic<uint32_t> simd_capabilities;
+	//! Rebuild the metric of the graph with the given capabilities. The exclusive lock must be held
+	void ConfigureMetric(uint32_t capabilities);
+
+	//! Search the graph for the candidates of a scan for the "limit" closest rows, skipping the invisible rows of the
+	//! scan state
+	void SearchGraph(HNSWIndexScanState &state, const float *query_vector, idx_t limit);
 };
 
+//! An HNSW index looked up by name, together with the catalog entries of the index and of its table
+struct HNSWIndexLookup {
+	IndexCatalogEntry &index_entry;
+	DuckTableEntry &table_entry;
+	HNSWIndex &index;
+};
+
+//! Look up the HNSW index "index_name", which may be qualified with a schema and a catalog. Binding the index loads it
+//! from disk, if it wasn't loaded yet
+HNSWIndexLookup LookupHNSWIndex(ClientContext &context, const string &index_name);
+
 } // namespace duckdb
\ No newline at end of file
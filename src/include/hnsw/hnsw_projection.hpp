@@ -0,0 +1,53 @@
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+
+namespace duckdb {
+
+class RandomEngine;
+class ColumnDataCollection;
+
+//! A linear projection of vectors into a lower-dimensional space, stored as a row-major
+//! (output_dims x input_dims) matrix with orthonormal rows
+class HNSWProjection {
+public:
+	HNSWProjection(idx_t input_dims, idx_t output_dims);
+
+	//! The number of dimensions of the vectors before projection
+	idx_t input_dims;
+	//! The number of dimensions of the vectors after projection
+	idx_t output_dims;
+	//! The projection matrix
+	vector<float> matrix;
+
+public:
+	//! Draw a random orthogonal projection
+	void InitializeRandom(RandomEngine &engine);
+	//! Learn the principal components of a sample of "count" vectors. If "center" is set, the components of the
+	//! covariance are used, otherwise the components of the uncentered second moment, which preserve inner products
+	void InitializePCA(const float *sample, idx_t count, bool center, RandomEngine &engine);
+
+	//! Project a vector of "input_dims" elements into "output", which must hold "output_dims" elements
+	void Project(const float *input, float *output) const;
+
+	//! Draw a uniform sample of up to "sample_size" vectors from the first column of a collection, using reservoir
+	//! sampling
+	static vector<float> SampleVectors(ColumnDataCollection &collection, idx_t sample_size);
+
+	//! The size of the projection matrix in bytes
+	idx_t GetSizeInBytes() const {
+		return matrix.size() * sizeof(float);
+	}
+
+	//! The supported kinds of projection
+	static const case_insensitive_set_t KINDS;
+	//! The number of vectors sampled to learn a PCA projection
+	static constexpr const idx_t SAMPLE_SIZE = 4096;
+
+private:
+	//! Orthonormalize the rows of the matrix using modified Gram-Schmidt
+	void Orthonormalize(RandomEngine &engine);
+};
+
+} // namespace duckdb
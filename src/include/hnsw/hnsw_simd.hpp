@@ -0,0 +1,20 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! Selects the SIMD kernels the HNSW indexes compute distances with
+struct HNSWSimd {
+	//! The setting that pins the kernels to an ISA level, "auto" picks the best one the CPU supports
+	static constexpr const char *TARGET_SETTING = "vss_simd_target";
+	//! The capability mask that allows all kernels
+	static constexpr const uint32_t ALL_CAPABILITIES = 0x7FFFFFFF;
+
+	//! Get the capability mask of a target, throws if the target is unknown
+	static uint32_t GetCapabilities(const string &target);
+	//! Get the capability mask of the target configured for the database
+	static uint32_t GetConfiguredCapabilities(DatabaseInstance &db);
+};
+
+} // namespace duckdb
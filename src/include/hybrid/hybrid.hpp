@@ -0,0 +1,17 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+struct HybridModule {
+public:
+	static void Register(DatabaseInstance &db) {
+		RegisterHybridSearch(db);
+	}
+
+private:
+	static void RegisterHybridSearch(DatabaseInstance &db);
+};
+
+} // namespace duckdb
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "duckdb/execution/index/bound_index.hpp"
+#include "duckdb/execution/index/index_pointer.hpp"
+#include "duckdb/execution/index/fixed_size_allocator.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+namespace duckdb {
+
+class StorageLock;
+
+//! A sparse vector as a list of (dimension, weight) pairs
+typedef vector<pair<int32_t, float>> sparse_vector_t;
+
+//! The postings of a single dimension, ordered by row id and divided into blocks of BLOCK_SIZE postings.
+//! The weight bounds of each block are used to skip blocks that cannot contribute to the top-k results.
+struct SparsePostingList {
+	//! The number of postings per block
+	static constexpr const idx_t BLOCK_SIZE = 128;
+
+	vector<row_t> row_ids;
+	vector<float> weights;
+	//! The largest and smallest weight in each block
+	vector<float> block_max;
+	vector<float> block_min;
+	//! The largest and smallest weight in the list
+	float max_weight = 0;
+	float min_weight = 0;
+	//! The number of postings that are sorted and covered by the block bounds, the rest was appended since
+	idx_t finalized_count = 0;
+
+public:
+	idx_t Count() const {
+		return row_ids.size();
+	}
+	void Append(row_t row_id, float weight) {
+		row_ids.push_back(row_id);
+		weights.push_back(weight);
+	}
+	//! Sort the appended postings into the list and update the block bounds
+	void Finalize();
+	//! Remove the postings of the given row ids, which must be sorted
+	void Remove(const vector<row_t> &sorted_row_ids);
+	//! The size of the list in bytes
+	idx_t GetSizeInBytes() const;
+
+private:
+	void UpdateBounds(idx_t first_block);
+};
+
+// Scan State
+struct SparseIndexScanState : public IndexScanState {
+	idx_t current_row = 0;
+	idx_t total_rows = 0;
+	//! The row ids of the results, ordered by descending score
+	unique_array<row_t> row_ids = nullptr;
+	//! The score of each result
+	unique_array<float> scores = nullptr;
+};
+
+class SparseIndex : public BoundIndex {
+public:
+	// The type name of the SparseIndex
+	static constexpr const char *TYPE_NAME = "SPARSE";
+
+public:
+	SparseIndex(const string &name, IndexConstraintType index_constraint_type, const vector<column_t> &column_ids,
+	            TableIOManager &table_io_manager, const vector<unique_ptr<Expression>> &unbound_expressions,
+	            AttachedDatabase &db, const case_insensitive_map_t<Value> &options,
+	            const IndexStorageInfo &info = IndexStorageInfo());
+
+	//! Block pointer to the root of the index
+	IndexPointer root_block_ptr;
+
+	//! The allocator used to persist linked blocks
+	unique_ptr<FixedSizeAllocator> linked_block_allocator;
+
+	unique_ptr<IndexScanState> InitializeScan(const sparse_vector_t &query, idx_t limit);
+	idx_t Scan(IndexScanState &state, Vector &result);
+
+	//! Add postings gathered while creating the index, FinalizePostings must be called once all are added
+	void AddPostings(unordered_map<int32_t, SparsePostingList> &other);
+	void FinalizePostings();
+
+	void Construct(DataChunk &input, Vector &row_ids);
+	void PersistToDisk();
+
+	static bool IsScoreFunction(const string &function_name);
+	static bool IsSparseVectorType(const LogicalType &type);
+	//! Get the non-zero (dimension, weight) pairs of a MAP(INTEGER, FLOAT) value
+	static sparse_vector_t GetSparseVector(const Value &value);
+
+	//! Call "func" with the row id, dimension and weight of every non-zero entry of a MAP(INTEGER, FLOAT) vector
+	template <class FUNC>
+	static void ForEachPosting(Vector &map_vec, Vector &row_ids, idx_t count, FUNC &&func) {
+		UnifiedVectorFormat map_format;
+		UnifiedVectorFormat key_format;
+		UnifiedVectorFormat value_format;
+		UnifiedVectorFormat rowid_format;
+
+		const auto entry_count = ListVector::GetListSize(map_vec);
+		map_vec.ToUnifiedFormat(count, map_format);
+		MapVector::GetKeys(map_vec).ToUnifiedFormat(entry_count, key_format);
+		MapVector::GetValues(map_vec).ToUnifiedFormat(entry_count, value_format);
+		row_ids.ToUnifiedFormat(count, rowid_format);
+
+		const auto map_ptr = UnifiedVectorFormat::GetData<list_entry_t>(map_format);
+		const auto key_ptr = UnifiedVectorFormat::GetData<int32_t>(key_format);
+		const auto value_ptr = UnifiedVectorFormat::GetData<float>(value_format);
+		const auto row_ptr = UnifiedVectorFormat::GetData<row_t>(rowid_format);
+
+		for (idx_t i = 0; i < count; i++) {
+			const auto map_idx = map_format.sel->get_index(i);
+			if (!map_format.validity.RowIsValid(map_idx)) {
+				continue;
+			}
+			const auto row_id = row_ptr[rowid_format.sel->get_index(i)];
+			const auto &entry = map_ptr[map_idx];
+			for (idx_t j = entry.offset; j < entry.offset + entry.length; j++) {
+				const auto value_idx = value_format.sel->get_index(j);
+				if (!value_format.validity.RowIsValid(value_idx) || value_ptr[value_idx] == 0) {
+					continue;
+				}
+				func(row_id, key_ptr[key_format.sel->get_index(j)], value_ptr[value_idx]);
+			}
+		}
+	}
+
+public:
+	//! Called when data is appended to the index. The lock obtained from InitializeLock must be held
+	ErrorData Append(IndexLock &lock, DataChunk &entries, Vector &row_identifiers) override;
+	//! Verify that data can be appended to the index without a constraint violation
+	void VerifyAppend(DataChunk &chunk) override;
+	//! Verify that data can be appended to the index without a constraint violation using the conflict manager
+	void VerifyAppend(DataChunk &chunk, ConflictManager &conflict_manager) override;
+	//! Deletes all data from the index. The lock obtained from InitializeLock must be held
+	void CommitDrop(IndexLock &index_lock) override;
+	//! Delete a chunk of entries from the index. The lock obtained from InitializeLock must be held
+	void Delete(IndexLock &lock, DataChunk &entries, Vector &row_identifiers) override;
+	//! Insert a chunk of entries into the index
+	ErrorData Insert(IndexLock &lock, DataChunk &data, Vector &row_ids) override;
+
+	IndexStorageInfo GetStorageInfo(const bool get_buffers) override;
+	idx_t GetInMemorySize(IndexLock &state) override;
+
+	//! Merge another index into this index. The lock obtained from InitializeLock must be held, and the other
+	//! index must also be locked during the merge
+	bool MergeIndexes(IndexLock &state, BoundIndex &other_index) override;
+
+	//! Vacuums the index. The lock obtained from InitializeLock must be held
+	void Vacuum(IndexLock &state) override;
+
+	//! Performs constraint checking for a chunk of input data
+	void CheckConstraintsForChunk(DataChunk &input, ConflictManager &conflict_manager) override;
+
+	//! Returns the string representation of the SparseIndex, or only traverses and verifies the index
+	string VerifyAndToString(IndexLock &state, const bool only_verify) override;
+
+	string GetConstraintViolationMessage(VerifyExistenceType verify_type, idx_t failed_index,
+	                                     DataChunk &input) override {
+		return "Constraint violation in SPARSE index";
+	}
+
+	void SetDirty() {
+		is_dirty = true;
+	}
+
+private:
+	//! The posting lists, by dimension
+	unordered_map<int32_t, SparsePostingList> postings;
+
+	bool is_dirty = false;
+	StorageLock rwlock;
+};
+
+} // namespace duckdb
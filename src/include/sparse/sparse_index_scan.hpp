@@ -0,0 +1,40 @@
+#pragma once
+
+#include "duckdb/function/table_function.hpp"
+#include "sparse/sparse_index.hpp"
+
+namespace duckdb {
+
+class DuckTableEntry;
+class Index;
+
+// This is created by the optimizer rule
+struct SparseIndexScanBindData : public TableFunctionData {
+	explicit SparseIndexScanBindData(DuckTableEntry &table, Index &index, idx_t limit, sparse_vector_t query)
+	    : table(table), index(index), limit(limit), query(std::move(query)) {
+	}
+
+	//! The table to scan
+	DuckTableEntry &table;
+
+	//! The index to use
+	Index &index;
+
+	//! The limit of the scan
+	idx_t limit;
+
+	//! The query vector
+	sparse_vector_t query;
+
+public:
+	bool Equals(const FunctionData &other_p) const override {
+		auto &other = other_p.Cast<SparseIndexScanBindData>();
+		return &other.table == &table && &other.index == &index && other.limit == limit && other.query == query;
+	}
+};
+
+struct SparseIndexScanFunction {
+	static TableFunction GetFunction();
+};
+
+} // namespace duckdb
@@ -1150,6 +1150,10 @@ struct index_update_config_t {
 
     /// @brief Optional thread identifier for multi-threaded construction.
     std::size_t thread = 0;
+
+    /// @brief Optional level to insert new entries at, instead of drawing a random one.
+    /// Used to build the upper levels of the graph before filling in the base level.
+    std::int32_t level = -1;
 };
 
 struct index_search_config_t {
@@ -1912,6 +1916,35 @@ class index_gt {
             computed_distances_count++;
             return metric(first, second);
         }
+
+        /**
+         *  @brief  Like `measure`, but lets metrics supporting it abandon the computation early,
+         *          once the distance is known to exceed the ::bound. The result is only exact,
+         *          if it's smaller or equal to the ::bound.
+         */
+        template <typename value_at, typename metric_at, typename entry_at> //
+        inline distance_t measure_bounded(value_at const& first, entry_at const& second, metric_at&& metric,
+                                          distance_t bound) noexcept {
+            static_assert( //
+                std::is_same<entry_at, member_cref_t>::value || std::is_same<entry_at, member_citerator_t>::value,
+                "Unexpected type");
+
+            computed_distances_count++;
+            return measure_bounded_(first, second, metric, bound, 0);
+        }
+
+      private:
+        template <typename value_at, typename metric_at, typename entry_at>
+        static inline auto measure_bounded_(value_at const& first, entry_at const& second, metric_at&& metric,
+                                            distance_t bound, int) noexcept -> decltype(metric(first, second, bound)) {
+            return metric(first, second, bound);
+        }
+
+        template <typename value_at, typename metric_at, typename entry_at>
+        static inline distance_t measure_bounded_(value_at const& first, entry_at const& second, metric_at&& metric,
+                                                  distance_t, long) noexcept {
+            return metric(first, second);
+        }
     };
 
     index_config_t config_{};
@@ -2069,7 +2102,8 @@ class index_gt {
         limits_ = index_limits_t{0, 0};
         nodes_capacity_ = 0;
         viewed_file_ = memory_mapped_file_t{};
-        tape_allocator_ = {};
+        // Release the arenas, but keep the configuration of the allocator
+        tape_allocator_ = tape_allocator_t(tape_allocator_);
     }
 
     /**
@@ -2324,7 +2358,8 @@ class index_gt {
         std::unique_lock<std::mutex> new_level_lock(global_mutex_);
         level_t max_level_copy = max_level_;      // Copy under lock
         std::size_t entry_idx_copy = entry_slot_; // Copy under lock
-        level_t target_level = choose_random_level_(context.level_generator);
+        level_t target_level = config.level >= 0 ? static_cast<level_t>(config.level)
+                                                 : choose_random_level_(context.level_generator);
 
         // Make sure we are not overflowing
         std::size_t capacity = nodes_capacity_.load();
@@ -2630,6 +2665,28 @@ class index_gt {
         return result;
     }
 
+    /**
+     *  @brief  Reads the nodes above the base level and their neighbors lists, which every search
+     *          passes through, so that they are resident and cached ahead of the first queries.
+     *  @param  touch Callback receiving the slots of the upper-level nodes and of their neighbors.
+     *  @return The number of nodes above the base level.
+     */
+    template <typename touch_at> std::size_t warmup_upper_levels(touch_at&& touch) const noexcept {
+        std::size_t nodes = 0;
+        for (std::size_t i = 0; i != size(); ++i) {
+            node_t node = node_at_(i);
+            if (node.level() == 0)
+                continue;
+
+            ++nodes;
+            touch(static_cast<compressed_slot_t>(i));
+            for (level_t level = 1; level <= node.level(); ++level)
+                for (compressed_slot_t neighbor_slot : neighbors_(node, level))
+                    touch(neighbor_slot);
+        }
+        return nodes;
+    }
+
     stats_t stats(stats_t* stats_per_level, std::size_t max_level) const noexcept {
 
         std::size_t head_bytes = node_head_bytes_();
@@ -2806,6 +2863,154 @@ class index_gt {
         return {};
     }
 
+    /**
+     *  @brief  Saves the index like `save_to_stream`, but stores only the used neighbors of every node,
+     *          sorted, delta-coded and bit-packed. Compacting the index first places the neighbors of a
+     *          node close to each other, which keeps the deltas small.
+     */
+    template <typename output_callback_at, typename progress_at = dummy_progress_t>
+    serialization_result_t save_compressed_to_stream(output_callback_at&& output,
+                                                     progress_at&& progress = {}) const noexcept {
+
+        serialization_result_t result;
+
+        index_serialized_header_t header;
+        header.size = nodes_count_;
+        header.connectivity = config_.connectivity;
+        header.connectivity_base = config_.connectivity_base;
+        header.max_level = max_level_;
+        header.entry_slot = entry_slot_;
+        if (!output(&header, sizeof(header)))
+            return result.failed("Failed to serialize the header into stream");
+
+        std::size_t processed = 0;
+        std::size_t const total = 2 * header.size;
+
+        // The levels come first, exactly like in the uncompressed format
+        for (std::size_t i = 0; i != header.size; ++i) {
+            level_t level = node_at_(i).level();
+            if (!output(&level, sizeof(level)))
+                return result.failed("Failed to serialize into stream");
+            if (!progress(++processed, total))
+                return result.failed("Terminated by user");
+        }
+
+        // Every node is prefixed with the length of its encoding
+        buffer_gt<byte_t, bytes_allocator_t> encoded(compressed_node_capacity_(max_level_));
+        buffer_gt<std::uint64_t, u64_allocator_t> sorted((std::max)(config_.connectivity, config_.connectivity_base));
+        if (!encoded || !sorted)
+            return result.failed("Out of memory");
+
+        for (std::size_t i = 0; i != header.size; ++i) {
+            node_t node = node_at_(i);
+            byte_t* end = encoded.data();
+            std::memcpy(end, node.tape(), node_head_bytes_());
+            end += node_head_bytes_();
+            for (level_t level = 0; level <= node.level(); ++level) {
+                neighbors_ref_t neighbors = neighbors_(node, level);
+                std::size_t count = neighbors.size();
+                for (std::size_t j = 0; j != count; ++j)
+                    sorted[j] = static_cast<std::uint64_t>(static_cast<std::size_t>(neighbors[j]));
+                std::sort(sorted.data(), sorted.data() + count);
+                end = encode_neighbors_(end, sorted.data(), count);
+            }
+
+            std::uint32_t length = static_cast<std::uint32_t>(end - encoded.data());
+            if (!output(&length, sizeof(length)) || !output(encoded.data(), length))
+                return result.failed("Failed to serialize into stream");
+            if (!progress(++processed, total))
+                return result.failed("Terminated by user");
+        }
+
+        return {};
+    }
+
+    /**
+     *  @brief  Symmetric to `save_compressed_to_stream`, pulls data from a stream.
+     */
+    template <typename input_callback_at, typename progress_at = dummy_progress_t>
+    serialization_result_t load_compressed_from_stream(input_callback_at&& input,
+                                                       progress_at&& progress = {}) noexcept {
+
+        serialization_result_t result;
+        reset();
+
+        index_serialized_header_t header;
+        if (!input(&header, sizeof(header)))
+            return result.failed("Failed to pull the header from the stream");
+        if (!header.size) {
+            reset();
+            return result;
+        }
+
+        using levels_allocator_t = typename dynamic_allocator_traits_t::template rebind_alloc<level_t>;
+        buffer_gt<level_t, levels_allocator_t> levels(header.size);
+        if (!levels)
+            return result.failed("Out of memory");
+        if (!input(levels, header.size * sizeof(level_t)))
+            return result.failed("Failed to pull nodes levels from the stream");
+
+        config_.connectivity = header.connectivity;
+        config_.connectivity_base = header.connectivity_base;
+        pre_ = precompute_(config_);
+        index_limits_t limits;
+        limits.members = header.size;
+        if (!reserve(limits)) {
+            reset();
+            return result.failed("Out of memory");
+        }
+        nodes_count_ = header.size;
+        max_level_ = static_cast<level_t>(header.max_level);
+        entry_slot_ = static_cast<compressed_slot_t>(header.entry_slot);
+
+        buffer_gt<byte_t, bytes_allocator_t> encoded(compressed_node_capacity_(max_level_));
+        if (!encoded) {
+            reset();
+            return result.failed("Out of memory");
+        }
+
+        for (std::size_t i = 0; i != header.size; ++i) {
+            std::uint32_t length = 0;
+            if (!input(&length, sizeof(length)) || length > encoded.size() || !input(encoded.data(), length)) {
+                reset();
+                return result.failed("Failed to pull nodes from the stream");
+            }
+
+            span_bytes_t node_bytes = node_malloc_(levels[i]);
+            if (!node_bytes) {
+                reset();
+                return result.failed("Out of memory");
+            }
+            std::memset(node_bytes.data(), 0, node_bytes.size());
+            node_t node{node_bytes.data()};
+            nodes_[i] = node;
+
+            byte_t const* begin = encoded.data();
+            byte_t const* end = begin + length;
+            if (length < node_head_bytes_()) {
+                reset();
+                return result.failed("Corrupted node in the stream");
+            }
+            std::memcpy(node.tape(), begin, node_head_bytes_());
+            begin += node_head_bytes_();
+            if (node.level() != levels[i]) {
+                reset();
+                return result.failed("Corrupted node in the stream");
+            }
+            for (level_t level = 0; level <= levels[i] && begin; ++level) {
+                std::size_t capacity = level ? config_.connectivity : config_.connectivity_base;
+                begin = decode_neighbors_(begin, end, capacity, neighbors_(node, level));
+            }
+            if (!begin) {
+                reset();
+                return result.failed("Corrupted node in the stream");
+            }
+            if (!progress(i + 1, header.size))
+                return result.failed("Terminated by user");
+        }
+        return {};
+    }
+
     template <typename progress_at = dummy_progress_t>
     serialization_result_t save(char const* file_path, progress_at&& progress = {}) const noexcept {
         return save(output_file_t(file_path), std::forward<progress_at>(progress));
@@ -3061,7 +3266,7 @@ class index_gt {
 
         // Erase all the incoming links
         buffer_gt<node_t, nodes_allocator_t> reordered_nodes(slots_and_levels.size());
-        tape_allocator_t reordered_tape;
+        tape_allocator_t reordered_tape(tape_allocator_);
 
         for (std::size_t new_slot = 0; new_slot != slots_and_levels.size(); ++new_slot) {
             std::size_t old_slot = slots_and_levels[new_slot].old_slot;
@@ -3165,6 +3370,108 @@ class index_gt {
         return pre_.neighbors_base_bytes + pre_.neighbors_bytes * level;
     }
 
+    using bytes_allocator_t = typename dynamic_allocator_traits_t::template rebind_alloc<byte_t>;
+    using u64_allocator_t = typename dynamic_allocator_traits_t::template rebind_alloc<std::uint64_t>;
+
+    /// @brief  The most bytes a compressed node of the given level may take.
+    std::size_t compressed_node_capacity_(level_t level) const noexcept {
+        // Two varints of up to 10 bytes and a bit width per level, and up to 8 bytes per packed neighbor
+        std::size_t per_level = 21 + 8 * (std::max)(config_.connectivity, config_.connectivity_base);
+        return node_head_bytes_() + per_level * (static_cast<std::size_t>((std::max)(level, level_t(0))) + 1);
+    }
+
+    static byte_t* encode_varint_(byte_t* out, std::uint64_t value) noexcept {
+        while (value >= 0x80) {
+            *out++ = static_cast<byte_t>(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        *out++ = static_cast<byte_t>(static_cast<unsigned char>(value));
+        return out;
+    }
+
+    static byte_t const* decode_varint_(byte_t const* in, byte_t const* end, std::uint64_t& value) noexcept {
+        value = 0;
+        for (unsigned shift = 0; in != end && shift < 64; shift += 7) {
+            std::uint64_t byte = static_cast<unsigned char>(*in++);
+            value |= (byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return in;
+        }
+        return nullptr;
+    }
+
+    /// @brief  Encodes sorted neighbors as their count, the first one, and the bit-packed deltas to the next ones.
+    static byte_t* encode_neighbors_(byte_t* out, std::uint64_t const* sorted, std::size_t count) noexcept {
+        out = encode_varint_(out, count);
+        if (!count)
+            return out;
+        out = encode_varint_(out, sorted[0]);
+
+        std::uint64_t max_delta = 0;
+        for (std::size_t i = 1; i != count; ++i)
+            max_delta = (std::max)(max_delta, sorted[i] - sorted[i - 1]);
+        unsigned width = 0;
+        while (width < 64 && (max_delta >> width))
+            ++width;
+        *out++ = static_cast<byte_t>(width);
+
+        std::size_t packed_bytes = static_cast<std::size_t>(((count - 1) * width + 7) / 8);
+        std::memset(out, 0, packed_bytes);
+        std::size_t bit = 0;
+        for (std::size_t i = 1; i != count; ++i) {
+            std::uint64_t delta = sorted[i] - sorted[i - 1];
+            for (unsigned written = 0; written < width;) {
+                std::size_t byte = bit / 8;
+                unsigned offset = static_cast<unsigned>(bit % 8);
+                unsigned take = (std::min)(width - written, 8u - offset);
+                unsigned chunk = static_cast<unsigned>((delta >> written) & ((1u << take) - 1));
+                out[byte] = static_cast<byte_t>(static_cast<unsigned char>(out[byte]) | (chunk << offset));
+                written += take;
+                bit += take;
+            }
+        }
+        out += packed_bytes;
+        return out;
+    }
+
+    /// @brief  Symmetric to `encode_neighbors_`, returns a null-pointer if the input is malformed.
+    static byte_t const* decode_neighbors_(byte_t const* in, byte_t const* end, std::size_t capacity,
+                                           neighbors_ref_t neighbors) noexcept {
+        std::uint64_t count = 0;
+        in = decode_varint_(in, end, count);
+        if (!in || count > capacity)
+            return nullptr;
+        if (!count)
+            return in;
+
+        std::uint64_t slot = 0;
+        in = decode_varint_(in, end, slot);
+        if (!in || in == end)
+            return nullptr;
+        unsigned width = static_cast<unsigned char>(*in++);
+        std::size_t packed_bytes = static_cast<std::size_t>(((count - 1) * width + 7) / 8);
+        if (width > 64 || static_cast<std::size_t>(end - in) < packed_bytes)
+            return nullptr;
+        neighbors.push_back(static_cast<compressed_slot_t>(slot));
+
+        std::size_t bit = 0;
+        for (std::uint64_t i = 1; i != count; ++i) {
+            std::uint64_t delta = 0;
+            for (unsigned read = 0; read < width;) {
+                std::size_t byte = bit / 8;
+                unsigned offset = static_cast<unsigned>(bit % 8);
+                unsigned take = (std::min)(width - read, 8u - offset);
+                std::uint64_t chunk = (static_cast<unsigned char>(in[byte]) >> offset) & ((1u << take) - 1);
+                delta |= chunk << read;
+                read += take;
+                bit += take;
+            }
+            slot += delta;
+            neighbors.push_back(static_cast<compressed_slot_t>(slot));
+        }
+        return in + packed_bytes;
+    }
+
     span_bytes_t node_malloc_(level_t level) noexcept {
         std::size_t node_bytes = node_bytes_(level);
         byte_t* data = (byte_t*)tape_allocator_.allocate(node_bytes);
@@ -3406,9 +3713,10 @@ class index_gt {
                     prefetch(missing_candidates.begin(), missing_candidates.end());
                 }
 
-                // Actual traversal
+                // Actual traversal, abandoning candidates as soon as they are farther than the closest one
                 for (compressed_slot_t candidate_slot : closest_neighbors) {
-                    distance_t candidate_dist = context.measure(query, citerator_at(candidate_slot), metric);
+                    distance_t candidate_dist =
+                        context.measure_bounded(query, citerator_at(candidate_slot), metric, closest_dist);
                     if (candidate_dist < closest_dist) {
                         closest_dist = candidate_dist;
                         closest_slot = candidate_slot;
@@ -3482,7 +3790,10 @@ class index_gt {
                     continue;
 
                 // node_lock_t successor_lock = node_lock_(successor_slot);
-                distance_t successor_dist = context.measure(query, citerator_at(successor_slot), metric);
+                // Once the `top` is full, anything farther than the `radius` is discarded anyway
+                distance_t successor_dist =
+                    top.size() < top_limit ? context.measure(query, citerator_at(successor_slot), metric)
+                                           : context.measure_bounded(query, citerator_at(successor_slot), metric, radius);
                 if (top.size() < top_limit || successor_dist < radius) {
                     // This can substantially grow our priority queue:
                     next.insert({-successor_dist, successor_slot});
@@ -3557,14 +3868,19 @@ class index_gt {
                 if (visits.set(successor_slot))
                     continue;
 
-                distance_t successor_dist = context.measure(query, citerator_at(successor_slot), metric);
+                // Once the `top` is full, anything farther than the `radius` is discarded anyway
+                distance_t successor_dist =
+                    top.size() < top_limit ? context.measure(query, citerator_at(successor_slot), metric)
+                                           : context.measure_bounded(query, citerator_at(successor_slot), metric, radius);
                 if (top.size() < top_limit || successor_dist < radius) {
                     // This can substantially grow our priority queue:
                     next.insert({-successor_dist, successor_slot});
                     if (is_dummy<predicate_at>() ||
                         predicate(member_cref_t{node_at_(successor_slot).ckey(), successor_slot}))
                         top.insert({successor_dist, successor_slot}, top_limit);
-                    radius = top.top().distance;
+                    // The predicate may have rejected every candidate so far
+                    if (top.size())
+                        radius = top.top().distance;
                 }
             }
         }
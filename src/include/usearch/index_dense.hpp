@@ -67,6 +67,9 @@ struct index_dense_head_t {
     misaligned_ref_gt<std::uint64_t> dimensions;
     misaligned_ref_gt<bool> multi;
 
+    // Layout: 1 byte, older files have it zeroed
+    misaligned_ref_gt<bool> compressed_neighbors;
+
     index_dense_head_t(byte_t* ptr) noexcept
         : magic((char const*)exchange(ptr, ptr + sizeof(magic_t))),         //
           version_major(exchange(ptr, ptr + sizeof(version_t))),            //
@@ -79,7 +82,8 @@ struct index_dense_head_t {
           count_present(exchange(ptr, ptr + sizeof(std::uint64_t))),        //
           count_deleted(exchange(ptr, ptr + sizeof(std::uint64_t))),        //
           dimensions(exchange(ptr, ptr + sizeof(std::uint64_t))),           //
-          multi(exchange(ptr, ptr + sizeof(bool))) {}
+          multi(exchange(ptr, ptr + sizeof(bool))),                         //
+          compressed_neighbors(exchange(ptr, ptr + sizeof(bool))) {}
 };
 
 struct index_dense_head_result_t {
@@ -112,6 +116,15 @@ struct index_dense_config_t : public index_config_t {
      */
     bool enable_key_lookups = true;
 
+    /**
+     *  @brief  How the arenas of the nodes and vectors are backed,
+     *          huge pages speed up searches over large indexes.
+     *
+     *  ! This configuration parameter doesn't affect the serialized file,
+     *  ! and is not preserved between runs.
+     */
+    huge_pages_t huge_pages = huge_pages_t::none_k;
+
     index_dense_config_t(index_config_t base) noexcept : index_config_t(base) {}
 
     index_dense_config_t(std::size_t c = default_connectivity(), std::size_t ea = default_expansion_add(),
@@ -132,6 +145,8 @@ struct index_dense_clustering_config_t {
 struct index_dense_serialization_config_t {
     bool exclude_vectors = false;
     bool use_64_bit_dimensions = false;
+    /// @brief Store the neighbor lists delta-coded and bit-packed, such files can't be viewed.
+    bool compress_neighbors = false;
 };
 
 struct index_dense_copy_config_t : public index_copy_config_t {
@@ -351,6 +366,13 @@ class index_dense_gt {
 
         inline distance_t operator()(byte_t const* a, byte_t const* b) const noexcept { return f(a, b); }
 
+        inline distance_t operator()(byte_t const* a, member_cref_t b, distance_t bound) const noexcept {
+            return index_->metric_(a, v(b), bound);
+        }
+        inline distance_t operator()(byte_t const* a, member_citerator_t b, distance_t bound) const noexcept {
+            return index_->metric_(a, v(b), bound);
+        }
+
         inline byte_t const* v(member_cref_t m) const noexcept { return index_->vectors_lookup_[get_slot(m)]; }
         inline byte_t const* v(member_citerator_t m) const noexcept { return index_->vectors_lookup_[get_slot(m)]; }
         inline distance_t f(byte_t const* a, byte_t const* b) const noexcept { return index_->metric_(a, b); }
@@ -512,6 +534,7 @@ class index_dense_gt {
         result.casts_ = make_casts_(scalar_kind);
         result.metric_ = metric;
         result.free_key_ = free_key;
+        result.vectors_tape_allocator_ = vectors_tape_allocator_t(config.huge_pages);
 
         // Fill the thread IDs.
         result.available_threads_.resize(hardware_threads);
@@ -519,7 +542,7 @@ class index_dense_gt {
 
         // Available since C11, but only C++17, so we use the C version.
         index_t* raw = index_allocator_t{}.allocate(1);
-        new (raw) index_t(config);
+        new (raw) index_t(config, {}, tape_allocator_t(config.huge_pages));
         result.typed_ = raw;
         return result;
     }
@@ -576,6 +599,45 @@ class index_dense_gt {
         return typed_->stats(stats_per_level, max_level);
     }
 
+    /**
+     *  @brief  Pulls the graph into the caches ahead of the first queries. Reads the upper levels
+     *          of the graph and the vectors of their nodes, then searches for the vectors of
+     *          @p queries nodes spread evenly over the index.
+     *  @return The number of nodes above the base level.
+     */
+    std::size_t warmup(std::size_t queries = 0, std::size_t thread = any_thread()) const {
+        std::size_t bytes_per_vector = metric_.bytes_per_vector();
+        byte_t checksum = 0;
+        std::size_t upper_nodes = typed_->warmup_upper_levels([&](compressed_slot_t slot) noexcept {
+            byte_t const* vector = vectors_lookup_[slot];
+            for (std::size_t offset = 0; offset < bytes_per_vector; offset += 64)
+                checksum ^= vector[offset];
+        });
+        // Keep the reads from being optimized away
+        volatile byte_t sink = checksum;
+        (void)sink;
+
+        std::size_t count = size();
+        queries = (std::min)(queries, count);
+        if (!queries)
+            return upper_nodes;
+
+        thread_lock_t lock = thread_lock_(thread);
+        index_search_config_t search_config;
+        search_config.thread = lock.thread_id;
+        search_config.expansion = config_.expansion_search;
+
+        auto &free_key_ = this->free_key_;
+        auto allow = [&free_key_](member_cref_t const& member) noexcept { return member.key != free_key_; };
+        for (std::size_t i = 0; i != queries; ++i) {
+            std::size_t slot = i * count / queries;
+            if (typed_->at(slot).key == free_key_)
+                continue;
+            typed_->search(vectors_lookup_[slot], 1, metric_proxy_t{*this}, search_config, allow);
+        }
+        return upper_nodes;
+    }
+
     dynamic_allocator_t const& allocator() const { return typed_->dynamic_allocator(); }
     vector_key_t const& free_key() const { return free_key_; }
 
@@ -593,6 +655,16 @@ class index_dense_gt {
             vectors_tape_allocator_.total_allocated();
     }
 
+    /**
+     *  @brief  The weakest kind of pages the nodes and the vectors are actually backed with.
+     *          Can be weaker than `config().huge_pages`, if the requested pages were not available.
+     */
+    huge_pages_t huge_pages_backing() const noexcept {
+        huge_pages_t nodes_backing = typed_->tape_allocator().backing();
+        huge_pages_t vectors_backing = vectors_tape_allocator_.backing();
+        return vectors_backing < nodes_backing ? vectors_backing : nodes_backing;
+    }
+
     static constexpr std::size_t any_thread() { return std::numeric_limits<std::size_t>::max(); }
     static constexpr distance_t infinite_distance() { return std::numeric_limits<distance_t>::max(); }
 
@@ -604,11 +676,11 @@ class index_dense_gt {
     };
 
     // clang-format off
-    add_result_t add(vector_key_t key, b1x8_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true) { return add_(key, vector, thread, force_vector_copy, casts_.from_b1x8); }
-    add_result_t add(vector_key_t key, i8_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true) { return add_(key, vector, thread, force_vector_copy, casts_.from_i8); }
-    add_result_t add(vector_key_t key, f16_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true) { return add_(key, vector, thread, force_vector_copy, casts_.from_f16); }
-    add_result_t add(vector_key_t key, f32_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true) { return add_(key, vector, thread, force_vector_copy, casts_.from_f32); }
-    add_result_t add(vector_key_t key, f64_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true) { return add_(key, vector, thread, force_vector_copy, casts_.from_f64); }
+    add_result_t add(vector_key_t key, b1x8_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true, std::int32_t level = -1) { return add_(key, vector, thread, force_vector_copy, casts_.from_b1x8, level); }
+    add_result_t add(vector_key_t key, i8_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true, std::int32_t level = -1) { return add_(key, vector, thread, force_vector_copy, casts_.from_i8, level); }
+    add_result_t add(vector_key_t key, f16_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true, std::int32_t level = -1) { return add_(key, vector, thread, force_vector_copy, casts_.from_f16, level); }
+    add_result_t add(vector_key_t key, f32_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true, std::int32_t level = -1) { return add_(key, vector, thread, force_vector_copy, casts_.from_f32, level); }
+    add_result_t add(vector_key_t key, f64_t const* vector, std::size_t thread = any_thread(), bool force_vector_copy = true, std::int32_t level = -1) { return add_(key, vector, thread, force_vector_copy, casts_.from_f64, level); }
 
     search_result_t search(b1x8_t const* vector, std::size_t wanted, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, dummy_predicate_t {}, thread, exact, casts_.from_b1x8, config_.expansion_search); }
     search_result_t search(i8_t const* vector, std::size_t wanted, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, dummy_predicate_t {}, thread, exact, casts_.from_i8, config_.expansion_search); }
@@ -622,6 +694,12 @@ class index_dense_gt {
     search_result_t ef_search(f32_t const* vector, std::size_t wanted, std::size_t ef_search, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, dummy_predicate_t {}, thread, exact, casts_.from_f32, ef_search); }
     search_result_t ef_search(f64_t const* vector, std::size_t wanted, std::size_t ef_search, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, dummy_predicate_t {}, thread, exact, casts_.from_f64, ef_search); }
 
+    template <typename predicate_at> search_result_t filtered_ef_search(b1x8_t const* vector, std::size_t wanted, std::size_t ef_search, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_b1x8, ef_search); }
+    template <typename predicate_at> search_result_t filtered_ef_search(i8_t const* vector, std::size_t wanted, std::size_t ef_search, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_i8, ef_search); }
+    template <typename predicate_at> search_result_t filtered_ef_search(f16_t const* vector, std::size_t wanted, std::size_t ef_search, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_f16, ef_search); }
+    template <typename predicate_at> search_result_t filtered_ef_search(f32_t const* vector, std::size_t wanted, std::size_t ef_search, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_f32, ef_search); }
+    template <typename predicate_at> search_result_t filtered_ef_search(f64_t const* vector, std::size_t wanted, std::size_t ef_search, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_f64, ef_search); }
+
     template <typename predicate_at> search_result_t filtered_search(b1x8_t const* vector, std::size_t wanted, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_b1x8, config_.expansion_search); }
     template <typename predicate_at> search_result_t filtered_search(i8_t const* vector, std::size_t wanted, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_i8, config_.expansion_search); }
     template <typename predicate_at> search_result_t filtered_search(f16_t const* vector, std::size_t wanted, predicate_at&& predicate, std::size_t thread = any_thread(), bool exact = false) const { return search_(vector, wanted, std::forward<predicate_at>(predicate), thread, exact, casts_.from_f16, config_.expansion_search); }
@@ -760,6 +838,7 @@ class index_dense_gt {
             std::unique_lock<std::mutex> available_threads_lock(available_threads_mutex_);
             available_threads_.resize(limits.threads());
             std::iota(available_threads_.begin(), available_threads_.end(), 0ul);
+            cast_buffer_.resize(available_threads_.size() * metric_.bytes_per_vector());
         }
         return typed_->reserve(limits);
     }
@@ -868,12 +947,16 @@ class index_dense_gt {
             head.count_deleted = typed_->size() - size();
             head.dimensions = dimensions();
             head.multi = multi();
+            head.compressed_neighbors = config.compress_neighbors;
 
             if (!output(&buffer, sizeof(buffer)))
                 return result.failed("Failed to serialize into stream");
         }
 
         // Save the actual proximity graph
+        if (config.compress_neighbors)
+            return typed_->save_compressed_to_stream(std::forward<output_callback_at>(output),
+                                                     std::forward<progress_at>(progress));
         return typed_->save_to_stream(std::forward<output_callback_at>(output), std::forward<progress_at>(progress));
     }
 
@@ -908,6 +991,7 @@ class index_dense_gt {
         serialization_result_t result;
         std::uint64_t matrix_rows = 0;
         std::uint64_t matrix_cols = 0;
+        bool compressed_neighbors = false;
 
         // We may not want to load the vectors from the same file, or allow attaching them afterwards
         if (!config.exclude_vectors) {
@@ -956,13 +1040,19 @@ class index_dense_gt {
                 return result.failed("Slot type doesn't match, consider rebuilding");
 
             config_.multi = head.multi;
+            compressed_neighbors = head.compressed_neighbors;
             metric_ = metric_t::builtin(head.dimensions, head.kind_metric, head.kind_scalar);
             cast_buffer_.resize(available_threads_.size() * metric_.bytes_per_vector());
             casts_ = make_casts_(head.kind_scalar);
         }
 
         // Pull the actual proximity graph
-        result = typed_->load_from_stream(std::forward<input_callback_at>(input), std::forward<progress_at>(progress));
+        if (compressed_neighbors)
+            result = typed_->load_compressed_from_stream(std::forward<input_callback_at>(input),
+                                                         std::forward<progress_at>(progress));
+        else
+            result =
+                typed_->load_from_stream(std::forward<input_callback_at>(input), std::forward<progress_at>(progress));
         if (!result)
             return result;
         if (typed_->size() != static_cast<std::size_t>(matrix_rows))
@@ -1040,6 +1130,8 @@ class index_dense_gt {
                 return result.failed("Key type doesn't match, consider rebuilding");
             if (head.kind_compressed_slot != unum::usearch::scalar_kind<compressed_slot_t>())
                 return result.failed("Slot type doesn't match, consider rebuilding");
+            if (head.compressed_neighbors)
+                return result.failed("Indexes with compressed neighbors can't be viewed, load them instead");
 
             config_.multi = head.multi;
             metric_ = metric_t::builtin(head.dimensions, head.kind_metric, head.kind_scalar);
@@ -1400,6 +1492,31 @@ class index_dense_gt {
         return result;
     }
 
+    /**
+     *  @brief Replaces the key of every vector in the index, e.g. after the entities they refer to were renumbered.
+     *  @param transform Callable mapping the current key of a vector to its new key.
+     *
+     *  Removed vectors keep the free key. The slot lookup table is rebuilt with the new keys, so that
+     *  the vectors can be removed or looked up by their new keys afterwards.
+     */
+    template <typename transform_at> error_t transform_keys(transform_at&& transform) {
+        unique_lock_t lookup_lock(slot_lookup_mutex_);
+        slot_lookup_.clear();
+        if (!slot_lookup_.try_reserve(typed_->size()))
+            return error_t("Out of memory!");
+        for (std::size_t slot = 0; slot != typed_->size(); ++slot) {
+            member_ref_t member = typed_->at(slot);
+            vector_key_t key = member.key;
+            if (key == free_key_)
+                continue;
+            vector_key_t new_key = static_cast<vector_key_t>(transform(key));
+            member.key = new_key;
+            if (!slot_lookup_.try_emplace(key_and_slot_t{new_key, static_cast<compressed_slot_t>(slot)}))
+                return error_t("Out of memory!");
+        }
+        return {};
+    }
+
     /**
      *  @brief Copies the ::index_dense_gt model @b without any data.
      *  @return A similarly configured ::index_dense_gt instance.
@@ -1415,12 +1532,13 @@ class index_dense_gt {
         other.metric_ = metric_;
         other.available_threads_ = available_threads_;
         other.free_key_ = free_key_;
+        other.vectors_tape_allocator_ = vectors_tape_allocator_t(config_.huge_pages);
 
         index_t* raw = index_allocator_t{}.allocate(1);
         if (!raw)
             return result.failed("Can't allocate the index");
 
-        new (raw) index_t(config());
+        new (raw) index_t(config(), {}, tape_allocator_t(config_.huge_pages));
         other.typed_ = raw;
         return result;
     }
@@ -1480,7 +1598,7 @@ class index_dense_gt {
         compaction_result_t result;
 
         std::vector<byte_t*> new_vectors_lookup(vectors_lookup_.size());
-        vectors_tape_allocator_t new_vectors_allocator;
+        vectors_tape_allocator_t new_vectors_allocator(config_.huge_pages);
 
         auto track_slot_change = [&](vector_key_t, compressed_slot_t old_slot, compressed_slot_t new_slot) {
             byte_t* new_vector = new_vectors_allocator.allocate(metric_.bytes_per_vector());
@@ -1488,8 +1606,19 @@ class index_dense_gt {
             std::memcpy(new_vector, old_vector, metric_.bytes_per_vector());
             new_vectors_lookup[new_slot] = new_vector;
         };
+        // The graph is only replaced once all the nodes are reordered, so if the progress callback
+        // aborts the compaction the vectors have to be left as they are as well
+        bool aborted = false;
+        auto tracked_progress = [&](std::size_t processed, std::size_t total) {
+            if (progress(processed, total))
+                return true;
+            aborted = true;
+            return false;
+        };
         typed_->compact(values_proxy_t{*this}, metric_proxy_t{*this}, track_slot_change,
-                        std::forward<executor_at>(executor), std::forward<progress_at>(progress));
+                        std::forward<executor_at>(executor), tracked_progress);
+        if (aborted)
+            return result.failed("Compaction aborted by the progress callback");
         vectors_lookup_ = std::move(new_vectors_lookup);
         vectors_tape_allocator_ = std::move(new_vectors_allocator);
         return result;
@@ -1747,7 +1876,7 @@ class index_dense_gt {
     template <typename scalar_at>
     add_result_t add_(                             //
         vector_key_t key, scalar_at const* vector, //
-        std::size_t thread, bool force_vector_copy, cast_t const& cast) {
+        std::size_t thread, bool force_vector_copy, cast_t const& cast, std::int32_t level = -1) {
 
         if (!multi() && contains(key))
             return add_result_t{}.failed("Duplicate keys not allowed in high-level wrappers");
@@ -1786,6 +1915,7 @@ class index_dense_gt {
         index_update_config_t update_config;
         update_config.thread = lock.thread_id;
         update_config.expansion = config_.expansion_add;
+        update_config.level = level;
 
         metric_proxy_t metric{*this};
         return reuse_node //
@@ -600,21 +600,61 @@ class aligned_allocator_gt {
 
 using aligned_allocator_t = aligned_allocator_gt<>;
 
+/**
+ *  @brief  How the pages of memory-mapped arenas are backed.
+ *          Huge pages reduce TLB misses during random graph walks over large indexes.
+ */
+enum class huge_pages_t {
+    /// @brief Regular pages.
+    none_k,
+    /// @brief Regular pages, aligned and advised to be merged into transparent huge pages.
+    transparent_k,
+    /// @brief Pre-allocated huge pages, falling back to transparent huge pages if none are available.
+    explicit_k,
+};
+
 class page_allocator_t {
+    huge_pages_t huge_pages_ = huge_pages_t::none_k;
+
   public:
     static constexpr std::size_t page_size() { return 4096; }
+    static constexpr std::size_t huge_page_size() { return 2 * 1024 * 1024; }
+
+    page_allocator_t() = default;
+    explicit page_allocator_t(huge_pages_t huge_pages) noexcept : huge_pages_(huge_pages) {}
 
     /**
      *  @brief Allocates an @b uninitialized block of memory of the specified size.
      *  @param count_bytes The number of bytes to allocate.
+     *  @param backing Optional output for the kind of pages the block is actually backed with.
      *  @return A pointer to the allocated memory block, or `nullptr` if allocation fails.
      */
-    byte_t* allocate(std::size_t count_bytes) const noexcept {
-        count_bytes = divide_round_up(count_bytes, page_size()) * page_size();
+    byte_t* allocate(std::size_t count_bytes, huge_pages_t* backing = nullptr) const noexcept {
+        count_bytes = rounded_size_(count_bytes);
+        huge_pages_t unused;
+        huge_pages_t& used = backing ? *backing : unused;
+        used = huge_pages_t::none_k;
 #if defined(USEARCH_DEFINED_WINDOWS)
         return (byte_t*)(::VirtualAlloc(NULL, count_bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
 #else
-        return (byte_t*)mmap(NULL, count_bytes, PROT_WRITE | PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, 0, 0);
+#if defined(MAP_HUGETLB)
+        if (huge_pages_ == huge_pages_t::explicit_k) {
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+            void* huge = mmap(NULL, count_bytes, PROT_WRITE | PROT_READ, flags, -1, 0);
+            if (huge != MAP_FAILED) {
+                used = huge_pages_t::explicit_k;
+                return (byte_t*)huge;
+            }
+        }
+#endif
+        if (huge_pages_ != huge_pages_t::none_k) {
+#if defined(MADV_HUGEPAGE)
+            used = huge_pages_t::transparent_k;
+#endif
+            return allocate_transparent_(count_bytes);
+        }
+        void* result = mmap(NULL, count_bytes, PROT_WRITE | PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return result == MAP_FAILED ? nullptr : (byte_t*)result;
 #endif
     }
 
@@ -622,10 +662,40 @@ class page_allocator_t {
 #if defined(USEARCH_DEFINED_WINDOWS)
         ::VirtualFree(page_pointer, 0, MEM_RELEASE);
 #else
-        count_bytes = divide_round_up(count_bytes, page_size()) * page_size();
-        munmap(page_pointer, count_bytes);
+        munmap(page_pointer, rounded_size_(count_bytes));
 #endif
     }
+
+  private:
+    std::size_t rounded_size_(std::size_t count_bytes) const noexcept {
+        std::size_t granularity = huge_pages_ == huge_pages_t::none_k ? page_size() : huge_page_size();
+        return divide_round_up(count_bytes, granularity) * granularity;
+    }
+
+#if !defined(USEARCH_DEFINED_WINDOWS)
+    /// @brief Maps a region aligned to the huge page size, so that the kernel can back it with huge pages.
+    static byte_t* allocate_transparent_(std::size_t count_bytes) noexcept {
+        std::size_t mapped_bytes = count_bytes + huge_page_size();
+        void* mapped = mmap(NULL, mapped_bytes, PROT_WRITE | PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED)
+            return nullptr;
+
+        // Trim the unaligned head and the tail of the mapping
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(mapped);
+        std::uintptr_t aligned = divide_round_up(address, huge_page_size()) * huge_page_size();
+        std::size_t head_bytes = aligned - address;
+        if (head_bytes)
+            munmap(mapped, head_bytes);
+        if (mapped_bytes - head_bytes - count_bytes)
+            munmap((byte_t*)aligned + count_bytes, mapped_bytes - head_bytes - count_bytes);
+
+#if defined(MADV_HUGEPAGE)
+        // Merely advisory, the kernel may not support or have enabled transparent huge pages
+        madvise((void*)aligned, count_bytes, MADV_HUGEPAGE);
+#endif
+        return (byte_t*)aligned;
+    }
+#endif
 };
 
 /**
@@ -649,6 +719,9 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
     std::size_t last_usage_ = head_size();
     std::size_t last_capacity_ = min_capacity();
     std::size_t wasted_space_ = 0;
+    huge_pages_t huge_pages_ = huge_pages_t::none_k;
+    /// @brief The weakest kind of pages any arena is actually backed with, or the requested kind without arenas.
+    huge_pages_t backing_ = huge_pages_t::none_k;
 
   public:
     using value_type = byte_t;
@@ -657,15 +730,20 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
     using const_pointer = byte_t const*;
 
     memory_mapping_allocator_gt() = default;
+    explicit memory_mapping_allocator_gt(huge_pages_t huge_pages) noexcept
+        : huge_pages_(huge_pages), backing_(huge_pages) {}
     memory_mapping_allocator_gt(memory_mapping_allocator_gt&& other) noexcept
         : last_arena_(exchange(other.last_arena_, nullptr)), last_usage_(exchange(other.last_usage_, 0)),
-          last_capacity_(exchange(other.last_capacity_, 0)), wasted_space_(exchange(other.wasted_space_, 0)) {}
+          last_capacity_(exchange(other.last_capacity_, 0)), wasted_space_(exchange(other.wasted_space_, 0)),
+          huge_pages_(other.huge_pages_), backing_(exchange(other.backing_, other.huge_pages_)) {}
 
     memory_mapping_allocator_gt& operator=(memory_mapping_allocator_gt&& other) noexcept {
         std::swap(last_arena_, other.last_arena_);
         std::swap(last_usage_, other.last_usage_);
         std::swap(last_capacity_, other.last_capacity_);
         std::swap(wasted_space_, other.wasted_space_);
+        std::swap(huge_pages_, other.huge_pages_);
+        std::swap(backing_, other.backing_);
         return *this;
     }
 
@@ -681,7 +759,7 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
             std::memcpy(&previous_arena, last_arena, sizeof(byte_t*));
             std::size_t last_cap = 0;
             std::memcpy(&last_cap, last_arena + sizeof(byte_t*), sizeof(std::size_t));
-            page_allocator_t{}.deallocate(last_arena, last_cap);
+            page_allocator_t{huge_pages_}.deallocate(last_arena, last_cap);
             last_arena = previous_arena;
         }
 
@@ -690,24 +768,36 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
         last_usage_ = head_size();
         last_capacity_ = min_capacity();
         wasted_space_ = 0;
+        backing_ = huge_pages_;
     }
 
     /**
      *  @brief Copy constructor.
-     *  @note This is a no-op copy constructor since the allocator is not copyable.
+     *  @note Only copies the configuration, since the arenas are not copyable.
      */
-    memory_mapping_allocator_gt(memory_mapping_allocator_gt const&) noexcept {}
+    memory_mapping_allocator_gt(memory_mapping_allocator_gt const& other) noexcept
+        : huge_pages_(other.huge_pages_), backing_(other.huge_pages_) {}
 
     /**
      *  @brief Copy assignment operator.
-     *  @note This is a no-op copy assignment operator since the allocator is not copyable.
+     *  @note Only copies the configuration, since the arenas are not copyable.
      *  @return Reference to the allocator after the assignment.
      */
-    memory_mapping_allocator_gt& operator=(memory_mapping_allocator_gt const&) noexcept {
+    memory_mapping_allocator_gt& operator=(memory_mapping_allocator_gt const& other) noexcept {
         reset();
+        huge_pages_ = other.huge_pages_;
+        backing_ = other.huge_pages_;
         return *this;
     }
 
+    huge_pages_t huge_pages() const noexcept { return huge_pages_; }
+
+    /**
+     *  @brief The kind of pages the memory is actually backed with, which can be weaker than the requested one
+     *         if no huge pages were reserved, or if the platform does not support them.
+     */
+    huge_pages_t backing() const noexcept { return backing_; }
+
     /**
      *  @brief Allocates an @b uninitialized block of memory of the specified size.
      *  @param count_bytes The number of bytes to allocate.
@@ -718,9 +808,12 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
         std::unique_lock<std::mutex> lock(mutex_);
         if (!last_arena_ || (last_usage_ + extended_bytes >= last_capacity_)) {
             std::size_t new_cap = (std::max)(last_capacity_, ceil2(extended_bytes)) * capacity_multiplier();
-            byte_t* new_arena = page_allocator_t{}.allocate(new_cap);
+            huge_pages_t arena_backing;
+            byte_t* new_arena = page_allocator_t{huge_pages_}.allocate(new_cap, &arena_backing);
             if (!new_arena)
                 return nullptr;
+            if (arena_backing < backing_)
+                backing_ = arena_backing;
             std::memcpy(new_arena, &last_arena_, sizeof(byte_t*));
             std::memcpy(new_arena + sizeof(byte_t*), &new_cap, sizeof(std::size_t));
 
@@ -1052,6 +1145,49 @@ template <typename scalar_at = float, typename result_at = scalar_at> struct met
     }
 };
 
+/**
+ *  @brief  Squared Euclidean (L2) distance with early abandoning.
+ *          Accumulates the distance in blocks of `block_k` dimensions and stops as soon as the
+ *          partial sum exceeds the provided `bound`. As the partial sums are monotonic, the
+ *          returned value is either the exact distance, or a value larger than `bound`.
+ */
+template <typename scalar_at = float, typename result_at = scalar_at> struct metric_l2sq_bounded_gt {
+    using scalar_t = scalar_at;
+    using result_t = result_at;
+
+    /// @brief Number of dimensions processed between two checks of the bound, one AVX-512 register of `f32`.
+    static constexpr std::size_t block_k = 16;
+
+    inline result_t operator()(scalar_t const* a, scalar_t const* b, std::size_t dim, result_t bound) const noexcept {
+        result_t ab_deltas_sq{};
+        std::size_t i = 0;
+        for (; i + block_k <= dim; i += block_k) {
+            result_t block_deltas_sq{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : block_deltas_sq)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t j = i; j != i + block_k; ++j) {
+                result_t aj = static_cast<result_t>(a[j]);
+                result_t bj = static_cast<result_t>(b[j]);
+                block_deltas_sq += square(aj - bj);
+            }
+            ab_deltas_sq += block_deltas_sq;
+            if (ab_deltas_sq > bound)
+                return ab_deltas_sq;
+        }
+        for (; i != dim; ++i) {
+            result_t ai = static_cast<result_t>(a[i]);
+            result_t bi = static_cast<result_t>(b[i]);
+            ab_deltas_sq += square(ai - bi);
+        }
+        return ab_deltas_sq;
+    }
+};
+
 /**
  *  @brief  Hamming distance computes the number of differing bits in
  *          two arrays of integers. An example would be a textual document,
@@ -1352,10 +1488,13 @@ class metric_punned_t {
     using metric_array_array_state_t = result_t (*)(uptr_t, uptr_t, uptr_t);
     /// Distance function callback, like `metric_array_array_size_t`, but depends on member variables.
     using metric_rounted_t = result_t (metric_punned_t::*)(uptr_t, uptr_t) const;
+    /// Distance function that takes two arrays, their length and an upper bound to abandon early at.
+    using metric_array_array_size_bound_t = result_t (*)(uptr_t, uptr_t, uptr_t, result_t);
 
     metric_rounted_t metric_routed_ = nullptr;
     uptr_t metric_ptr_ = 0;
     uptr_t metric_third_arg_ = 0;
+    uptr_t metric_bounded_ptr_ = 0;
 
     std::size_t dimensions_ = 0;
     metric_kind_t metric_kind_ = metric_kind_t::unknown_k;
@@ -1375,6 +1514,23 @@ class metric_punned_t {
         return (this->*metric_routed_)(reinterpret_cast<uptr_t>(a), reinterpret_cast<uptr_t>(b));
     }
 
+    /**
+     *  @brief  Computes the distance between two vectors of fixed length, allowing the kernel
+     *          to stop early, once the partial result exceeds the ::bound. In that case the
+     *          returned value is only guaranteed to be larger than ::bound.
+     *
+     *  Falls back to the complete computation for metrics without a bounded kernel.
+     */
+    inline result_t operator()(byte_t const* a, byte_t const* b, result_t bound) const noexcept {
+        if (!metric_bounded_ptr_)
+            return (*this)(a, b);
+        auto function_pointer = (metric_array_array_size_bound_t)(metric_bounded_ptr_);
+        return function_pointer(reinterpret_cast<uptr_t>(a), reinterpret_cast<uptr_t>(b), metric_third_arg_, bound);
+    }
+
+    /// @brief Checks if the metric can abandon distance computations early.
+    inline bool bounded() const noexcept { return metric_bounded_ptr_ != 0; }
+
     inline metric_punned_t() noexcept = default;
     inline metric_punned_t(metric_punned_t const&) noexcept = default;
     inline metric_punned_t& operator=(metric_punned_t const&) noexcept = default;
@@ -1413,6 +1569,9 @@ class metric_punned_t {
 #else
         metric.configure_with_autovec();
 #endif
+        // The early-abandoning kernels are plain loops, which lose to the SIMD kernels of SimSIMD
+        if (!metric.simd_accelerated())
+            metric.configure_bounded();
 
         return metric;
     }
@@ -1469,6 +1628,33 @@ class metric_punned_t {
         return metric;
     }
 
+    /**
+     *  @brief  Creates a natively supported metric like ::builtin, but only using the SimSIMD kernels
+     *          of the given capabilities, e.g. to compare ISA levels in reproducible benchmarks.
+     *          Falls back to the auto-vectorized backend if none of them provides a kernel for
+     *          this metric. Early abandoning is disabled, as its kernel is the same for all ISA levels.
+     *
+     *  @param  allowed_capabilities    A bitmask of `simsimd_capability_t` values.
+     */
+    inline static metric_punned_t builtin_restricted(std::size_t dimensions, metric_kind_t metric_kind,
+                                                     scalar_kind_t scalar_kind,
+                                                     std::uint32_t allowed_capabilities) noexcept {
+        metric_punned_t metric = builtin(dimensions, metric_kind, scalar_kind);
+        metric.metric_routed_ = &metric_punned_t::invoke_array_array_third;
+        metric.metric_ptr_ = 0;
+        metric.metric_bounded_ptr_ = 0;
+#if USEARCH_USE_SIMSIMD
+        static simsimd_capability_t static_capabilities = simsimd_capabilities();
+        metric.isa_kind_ = simsimd_cap_serial_k;
+        if (!metric.configure_with_simsimd((simsimd_capability_t)(static_capabilities & allowed_capabilities)))
+            metric.configure_with_autovec();
+#else
+        (void)allowed_capabilities;
+        metric.configure_with_autovec();
+#endif
+        return metric;
+    }
+
     inline std::size_t dimensions() const noexcept { return dimensions_; }
     inline metric_kind_t metric_kind() const noexcept { return metric_kind_; }
     inline scalar_kind_t scalar_kind() const noexcept { return scalar_kind_; }
@@ -1483,6 +1669,15 @@ class metric_punned_t {
      */
     inline bool missing() const noexcept { return !bool(*this) && metric_kind_ != metric_kind_t::unknown_k; }
 
+    /// @brief Checks if the distances are computed by a SIMD kernel of SimSIMD, rather than a serial one.
+    inline bool simd_accelerated() const noexcept {
+#if USEARCH_USE_SIMSIMD
+        return isa_kind_ != simsimd_cap_serial_k;
+#else
+        return false;
+#endif
+    }
+
     inline char const* isa_name() const noexcept {
         if (!*this)
             return "uninitialized";
@@ -1496,6 +1691,7 @@ class metric_punned_t {
         case simsimd_cap_skylake_k: return "skylake";
         case simsimd_cap_ice_k: return "ice";
         case simsimd_cap_sapphire_k: return "sapphire";
+        case simsimd_cap_genoa_k: return "genoa";
         default: return "unknown";
         }
 #endif
@@ -1642,11 +1838,37 @@ class metric_punned_t {
         }
     }
 
+    /**
+     *  @brief  Picks an early-abandoning kernel, if one exists for the metric.
+     *          Only metrics with monotonically growing partial sums qualify, so the inner-product
+     *          and cosine kernels, whose partial sums can both grow and shrink, are not bounded.
+     */
+    void configure_bounded() noexcept {
+        metric_bounded_ptr_ = 0;
+        if (metric_kind_ != metric_kind_t::l2sq_k)
+            return;
+        switch (scalar_kind_) {
+        case scalar_kind_t::f32_k: metric_bounded_ptr_ = (uptr_t)&bounded_<metric_l2sq_bounded_gt<f32_t>>; break;
+        case scalar_kind_t::f16_k: metric_bounded_ptr_ = (uptr_t)&bounded_<metric_l2sq_bounded_gt<f16_t, f32_t>>; break;
+        case scalar_kind_t::i8_k: metric_bounded_ptr_ = (uptr_t)&bounded_<metric_l2sq_bounded_gt<i8_t, f32_t>>; break;
+        case scalar_kind_t::f64_k: metric_bounded_ptr_ = (uptr_t)&bounded_<metric_l2sq_bounded_gt<f64_t>>; break;
+        default: break;
+        }
+    }
+
     template <typename typed_at>
     inline static result_t equidimensional_(uptr_t a, uptr_t b, uptr_t a_dimensions) noexcept {
         using scalar_t = typename typed_at::scalar_t;
         return static_cast<result_t>(typed_at{}((scalar_t const*)a, (scalar_t const*)b, a_dimensions));
     }
+
+    template <typename typed_at>
+    inline static result_t bounded_(uptr_t a, uptr_t b, uptr_t a_dimensions, result_t bound) noexcept {
+        using scalar_t = typename typed_at::scalar_t;
+        using typed_result_t = typename typed_at::result_t;
+        return static_cast<result_t>(
+            typed_at{}((scalar_t const*)a, (scalar_t const*)b, a_dimensions, static_cast<typed_result_t>(bound)));
+    }
 };
 
 /**
@@ -1959,6 +2181,7 @@ class flat_hash_multi_set_gt {
         clear(); // Clear all elements
         if (data_)
             allocator_t{}.deallocate(data_, buckets_ * bytes_per_bucket());
+        data_ = nullptr;
         buckets_ = 0;
         populated_slots_ = 0;
         capacity_slots_ = 0;
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+struct VecsModule {
+public:
+	static void Register(DatabaseInstance &db) {
+		RegisterReadVecs(db);
+	}
+
+private:
+	static void RegisterReadVecs(DatabaseInstance &db);
+};
+
+} // namespace duckdb
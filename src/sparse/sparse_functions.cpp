@@ -0,0 +1,76 @@
+#include "duckdb/common/vector_operations/binary_executor.hpp"
+#include "duckdb/function/scalar_function.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+#include "sparse/sparse.hpp"
+
+namespace duckdb {
+
+//-------------------------------------------------------------------------
+// Sparse Inner Product
+//-------------------------------------------------------------------------
+static void SparseInnerProductFunction(DataChunk &args, ExpressionState &state, Vector &result) {
+	auto &lhs = args.data[0];
+	auto &rhs = args.data[1];
+	const auto count = args.size();
+
+	UnifiedVectorFormat lhs_keys;
+	UnifiedVectorFormat lhs_values;
+	UnifiedVectorFormat rhs_keys;
+	UnifiedVectorFormat rhs_values;
+	MapVector::GetKeys(lhs).ToUnifiedFormat(ListVector::GetListSize(lhs), lhs_keys);
+	MapVector::GetValues(lhs).ToUnifiedFormat(ListVector::GetListSize(lhs), lhs_values);
+	MapVector::GetKeys(rhs).ToUnifiedFormat(ListVector::GetListSize(rhs), rhs_keys);
+	MapVector::GetValues(rhs).ToUnifiedFormat(ListVector::GetListSize(rhs), rhs_values);
+
+	// The weights of one side, by dimension
+	unordered_map<int32_t, float> lookup;
+
+	BinaryExecutor::Execute<list_entry_t, list_entry_t, float>(
+	    lhs, rhs, result, count, [&](const list_entry_t &lhs_entry, const list_entry_t &rhs_entry) {
+		    // Build the lookup from the smaller of the two maps, and probe it with the other
+		    auto swap = lhs_entry.length > rhs_entry.length;
+		    auto &build_entry = swap ? rhs_entry : lhs_entry;
+		    auto &build_keys = swap ? rhs_keys : lhs_keys;
+		    auto &build_values = swap ? rhs_values : lhs_values;
+		    auto &probe_entry = swap ? lhs_entry : rhs_entry;
+		    auto &probe_keys = swap ? lhs_keys : rhs_keys;
+		    auto &probe_values = swap ? lhs_values : rhs_values;
+
+		    lookup.clear();
+		    for (idx_t i = build_entry.offset; i < build_entry.offset + build_entry.length; i++) {
+			    const auto value_idx = build_values.sel->get_index(i);
+			    if (!build_values.validity.RowIsValid(value_idx)) {
+				    continue;
+			    }
+			    const auto key = UnifiedVectorFormat::GetData<int32_t>(build_keys)[build_keys.sel->get_index(i)];
+			    lookup[key] = UnifiedVectorFormat::GetData<float>(build_values)[value_idx];
+		    }
+
+		    float sum = 0;
+		    for (idx_t i = probe_entry.offset; i < probe_entry.offset + probe_entry.length; i++) {
+			    const auto value_idx = probe_values.sel->get_index(i);
+			    if (!probe_values.validity.RowIsValid(value_idx)) {
+				    continue;
+			    }
+			    const auto key = UnifiedVectorFormat::GetData<int32_t>(probe_keys)[probe_keys.sel->get_index(i)];
+			    auto entry = lookup.find(key);
+			    if (entry != lookup.end()) {
+				    sum += entry->second * UnifiedVectorFormat::GetData<float>(probe_values)[value_idx];
+			    }
+		    }
+		    return sum;
+	    });
+}
+
+//-------------------------------------------------------------------------
+// Register
+//-------------------------------------------------------------------------
+void SparseModule::RegisterFunctions(DatabaseInstance &db) {
+	auto sparse_type = LogicalType::MAP(LogicalType::INTEGER, LogicalType::FLOAT);
+	ScalarFunction fun("sparse_inner_product", {sparse_type, sparse_type}, LogicalType::FLOAT,
+	                   SparseInnerProductFunction);
+	ExtensionUtil::RegisterFunction(db, fun);
+}
+
+} // namespace duckdb
@@ -0,0 +1,562 @@
+#include "sparse/sparse_index.hpp"
+
+#include "duckdb/execution/index/fixed_size_allocator.hpp"
+#include "duckdb/storage/partial_block_manager.hpp"
+#include "duckdb/storage/table_io_manager.hpp"
+#include "common/linked_block.hpp"
+#include "sparse/sparse.hpp"
+
+namespace duckdb {
+
+//------------------------------------------------------------------------------
+// Posting Lists
+//------------------------------------------------------------------------------
+
+constexpr idx_t SparsePostingList::BLOCK_SIZE;
+
+void SparsePostingList::Finalize() {
+	if (finalized_count == Count()) {
+		return;
+	}
+
+	// Rows are usually appended in row id order, in which case only the trailing blocks need to be updated
+	auto is_ordered = finalized_count == 0 || row_ids[finalized_count - 1] < row_ids[finalized_count];
+	for (idx_t i = finalized_count + 1; is_ordered && i < Count(); i++) {
+		is_ordered = row_ids[i - 1] < row_ids[i];
+	}
+
+	if (is_ordered) {
+		UpdateBounds(finalized_count / BLOCK_SIZE);
+	} else {
+		vector<pair<row_t, float>> entries;
+		entries.reserve(Count());
+		for (idx_t i = 0; i < Count(); i++) {
+			entries.emplace_back(row_ids[i], weights[i]);
+		}
+		std::sort(entries.begin(), entries.end());
+		for (idx_t i = 0; i < Count(); i++) {
+			row_ids[i] = entries[i].first;
+			weights[i] = entries[i].second;
+		}
+		UpdateBounds(0);
+	}
+	finalized_count = Count();
+}
+
+void SparsePostingList::Remove(const vector<row_t> &sorted_row_ids) {
+	D_ASSERT(finalized_count == Count());
+	if (sorted_row_ids.empty()) {
+		return;
+	}
+
+	// Nothing before the smallest removed row id changes
+	auto first = static_cast<idx_t>(std::lower_bound(row_ids.begin(), row_ids.end(), sorted_row_ids.front()) -
+	                                row_ids.begin());
+	auto result_count = first;
+	for (idx_t i = first; i < Count(); i++) {
+		if (std::binary_search(sorted_row_ids.begin(), sorted_row_ids.end(), row_ids[i])) {
+			continue;
+		}
+		row_ids[result_count] = row_ids[i];
+		weights[result_count] = weights[i];
+		result_count++;
+	}
+	if (result_count == Count()) {
+		return;
+	}
+
+	row_ids.resize(result_count);
+	weights.resize(result_count);
+	finalized_count = result_count;
+	UpdateBounds(first / BLOCK_SIZE);
+}
+
+void SparsePostingList::UpdateBounds(idx_t first_block) {
+	const auto block_count = (Count() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	block_max.resize(block_count);
+	block_min.resize(block_count);
+
+	for (idx_t block_idx = first_block; block_idx < block_count; block_idx++) {
+		const auto begin = block_idx * BLOCK_SIZE;
+		const auto end = MinValue(begin + BLOCK_SIZE, Count());
+		auto max = weights[begin];
+		auto min = weights[begin];
+		for (idx_t i = begin + 1; i < end; i++) {
+			max = MaxValue(max, weights[i]);
+			min = MinValue(min, weights[i]);
+		}
+		block_max[block_idx] = max;
+		block_min[block_idx] = min;
+	}
+
+	max_weight = 0;
+	min_weight = 0;
+	if (block_count > 0) {
+		max_weight = *std::max_element(block_max.begin(), block_max.end());
+		min_weight = *std::min_element(block_min.begin(), block_min.end());
+	}
+}
+
+idx_t SparsePostingList::GetSizeInBytes() const {
+	return row_ids.capacity() * sizeof(row_t) +
+	       (weights.capacity() + block_max.capacity() + block_min.capacity()) * sizeof(float);
+}
+
+//------------------------------------------------------------------------------
+// SparseIndex Methods
+//------------------------------------------------------------------------------
+
+// Constructor
+SparseIndex::SparseIndex(const string &name, IndexConstraintType index_constraint_type,
+                         const vector<column_t> &column_ids, TableIOManager &table_io_manager,
+                         const vector<unique_ptr<Expression>> &unbound_expressions, AttachedDatabase &db,
+                         const case_insensitive_map_t<Value> &options, const IndexStorageInfo &info)
+    : BoundIndex(name, TYPE_NAME, index_constraint_type, column_ids, table_io_manager, unbound_expressions, db) {
+
+	if (index_constraint_type != IndexConstraintType::NONE) {
+		throw NotImplementedException("SPARSE indexes do not support unique or primary key constraints");
+	}
+
+	// Create a allocator for the linked blocks
+	auto &block_manager = table_io_manager.GetIndexBlockManager();
+	linked_block_allocator = make_uniq<FixedSizeAllocator>(sizeof(LinkedBlock), block_manager);
+
+	// We only support one MAP(INTEGER, FLOAT) column
+	D_ASSERT(logical_types.size() == 1);
+	D_ASSERT(IsSparseVectorType(logical_types[0]));
+
+	auto lock = rwlock.GetExclusiveLock();
+	// Is this a new index or an existing index?
+	if (info.IsValid()) {
+		// This is an old index that needs to be loaded
+
+		// Set the root node
+		root_block_ptr.Set(info.root);
+		D_ASSERT(info.allocator_infos.size() == 1);
+		linked_block_allocator->Init(info.allocator_infos[0]);
+
+		// Is there anything to deserialize? We could have an empty index
+		if (!info.allocator_infos[0].buffer_ids.empty()) {
+			LinkedBlockReader reader(*linked_block_allocator, root_block_ptr);
+
+			// The lists are stored one after another as (dimension, count, row ids, weights)
+			idx_t list_count;
+			reader.ReadData(data_ptr_cast(&list_count), sizeof(idx_t));
+			for (idx_t i = 0; i < list_count; i++) {
+				int32_t dimension;
+				idx_t count;
+				reader.ReadData(data_ptr_cast(&dimension), sizeof(int32_t));
+				reader.ReadData(data_ptr_cast(&count), sizeof(idx_t));
+
+				auto &list = postings[dimension];
+				list.row_ids.resize(count);
+				list.weights.resize(count);
+				reader.ReadData(data_ptr_cast(list.row_ids.data()), count * sizeof(row_t));
+				reader.ReadData(data_ptr_cast(list.weights.data()), count * sizeof(float));
+				list.Finalize();
+			}
+		}
+	}
+}
+
+bool SparseIndex::IsScoreFunction(const string &function_name) {
+	return function_name == "sparse_inner_product";
+}
+
+bool SparseIndex::IsSparseVectorType(const LogicalType &type) {
+	return type.id() == LogicalTypeId::MAP && MapType::KeyType(type).id() == LogicalTypeId::INTEGER &&
+	       MapType::ValueType(type).id() == LogicalTypeId::FLOAT;
+}
+
+sparse_vector_t SparseIndex::GetSparseVector(const Value &value) {
+	sparse_vector_t result;
+	if (value.IsNull()) {
+		return result;
+	}
+	for (auto &entry : MapValue::GetChildren(value)) {
+		auto &key_value = StructValue::GetChildren(entry);
+		if (key_value[1].IsNull()) {
+			continue;
+		}
+		auto weight = key_value[1].GetValue<float>();
+		if (weight == 0) {
+			continue;
+		}
+		result.emplace_back(key_value[0].GetValue<int32_t>(), weight);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------------
+// Search
+//------------------------------------------------------------------------------
+
+// A cursor over the posting list of one dimension of the query
+struct SparsePostingCursor {
+	SparsePostingCursor(const SparsePostingList &list_p, float weight_p) : list(&list_p), weight(weight_p), pos(0) {
+		max_score = BoundScore(list->max_weight, list->min_weight);
+	}
+
+	const SparsePostingList *list;
+	//! The weight of the dimension in the query
+	float weight;
+	//! The upper bound of the contribution of this dimension to the score of any row
+	float max_score;
+	idx_t pos;
+
+	row_t Row() const {
+		return pos < list->Count() ? list->row_ids[pos] : NumericLimits<row_t>::Maximum();
+	}
+	float Score() const {
+		return weight * list->weights[pos];
+	}
+	//! The position of the first posting at or after "target"
+	idx_t Find(row_t target) const {
+		auto begin = list->row_ids.begin() + static_cast<ptrdiff_t>(pos);
+		return static_cast<idx_t>(std::lower_bound(begin, list->row_ids.end(), target) - list->row_ids.begin());
+	}
+	void SeekTo(row_t target) {
+		pos = Find(target);
+	}
+	//! The upper bound of the contribution of this dimension to the rows from "target" up to and including
+	//! "last_row", the last row of the block that "target" falls into
+	float BlockMaxScore(row_t target, row_t &last_row) const {
+		auto idx = Find(target);
+		if (idx == list->Count()) {
+			last_row = NumericLimits<row_t>::Maximum();
+			return 0;
+		}
+		auto block_idx = idx / SparsePostingList::BLOCK_SIZE;
+		last_row = list->row_ids[MinValue((block_idx + 1) * SparsePostingList::BLOCK_SIZE, list->Count()) - 1];
+		return BoundScore(list->block_max[block_idx], list->block_min[block_idx]);
+	}
+	float BoundScore(float max, float min) const {
+		// Weights can be negative, and a row that is not in the list does not score anything
+		return MaxValue<float>(0, weight > 0 ? weight * max : weight * min);
+	}
+};
+
+unique_ptr<IndexScanState> SparseIndex::InitializeScan(const sparse_vector_t &query, idx_t limit) {
+	auto state = make_uniq<SparseIndexScanState>();
+
+	// Acquire a shared lock to search the index
+	auto lock = rwlock.GetSharedLock();
+
+	vector<SparsePostingCursor> cursors;
+	for (auto &entry : query) {
+		auto list = postings.find(entry.first);
+		if (list != postings.end() && list->second.Count() != 0) {
+			cursors.emplace_back(list->second, entry.second);
+		}
+	}
+
+	// The best results so far, as a min-heap on the score
+	vector<pair<float, row_t>> top;
+	const auto heap_compare = std::greater<pair<float, row_t>>();
+	const auto end_row = NumericLimits<row_t>::Maximum();
+
+	// Block-max WAND: only rows whose upper bound beats the current k-th best score are scored
+	while (limit > 0) {
+		const auto threshold = top.size() < limit ? NumericLimits<float>::Minimum() : top.front().first;
+
+		std::sort(cursors.begin(), cursors.end(),
+		          [](const SparsePostingCursor &a, const SparsePostingCursor &b) { return a.Row() < b.Row(); });
+
+		// Find the pivot, the first cursor at which the summed upper bounds can beat the threshold
+		idx_t pivot = cursors.size();
+		float upper_bound = 0;
+		for (idx_t i = 0; i < cursors.size() && cursors[i].Row() != end_row; i++) {
+			upper_bound += cursors[i].max_score;
+			if (upper_bound > threshold) {
+				pivot = i;
+				break;
+			}
+		}
+		if (pivot == cursors.size()) {
+			// No remaining row can make it into the results
+			break;
+		}
+		const auto pivot_row = cursors[pivot].Row();
+		while (pivot + 1 < cursors.size() && cursors[pivot + 1].Row() == pivot_row) {
+			pivot++;
+		}
+
+		// Check the tighter bound from the blocks the pivot row falls into
+		auto skip_to = pivot + 1 < cursors.size() ? cursors[pivot + 1].Row() : end_row;
+		float block_bound = 0;
+		for (idx_t i = 0; i <= pivot; i++) {
+			row_t last_row;
+			block_bound += cursors[i].BlockMaxScore(pivot_row, last_row);
+			skip_to = MinValue(skip_to, last_row == end_row ? end_row : last_row + 1);
+		}
+		if (block_bound <= threshold) {
+			// None of the rows before "skip_to" can make it into the results
+			for (idx_t i = 0; i <= pivot; i++) {
+				cursors[i].SeekTo(skip_to);
+			}
+			continue;
+		}
+
+		if (cursors[0].Row() != pivot_row) {
+			// Move the cursors before the pivot up to the pivot row
+			for (idx_t i = 0; i < pivot && cursors[i].Row() < pivot_row; i++) {
+				cursors[i].SeekTo(pivot_row);
+			}
+			continue;
+		}
+
+		// All cursors up to the pivot are positioned at the pivot row, score it
+		float score = 0;
+		for (idx_t i = 0; i <= pivot; i++) {
+			score += cursors[i].Score();
+			cursors[i].pos++;
+		}
+		if (top.size() < limit) {
+			top.emplace_back(score, pivot_row);
+			std::push_heap(top.begin(), top.end(), heap_compare);
+		} else if (score > threshold) {
+			std::pop_heap(top.begin(), top.end(), heap_compare);
+			top.back() = make_pair(score, pivot_row);
+			std::push_heap(top.begin(), top.end(), heap_compare);
+		}
+	}
+
+	// Order the results by descending score
+	std::sort_heap(top.begin(), top.end(), heap_compare);
+
+	state->current_row = 0;
+	state->total_rows = top.size();
+	state->row_ids = make_uniq_array<row_t>(top.size());
+	state->scores = make_uniq_array<float>(top.size());
+	for (idx_t i = 0; i < top.size(); i++) {
+		state->row_ids[i] = top[i].second;
+		state->scores[i] = top[i].first;
+	}
+	return std::move(state);
+}
+
+idx_t SparseIndex::Scan(IndexScanState &state, Vector &result) {
+	auto &scan_state = state.Cast<SparseIndexScanState>();
+
+	idx_t count = 0;
+	auto row_ids = FlatVector::GetData<row_t>(result);
+
+	// Push the row ids into the result vector, up to STANDARD_VECTOR_SIZE or the
+	// end of the result set
+	while (count < STANDARD_VECTOR_SIZE && scan_state.current_row < scan_state.total_rows) {
+		row_ids[count++] = scan_state.row_ids[scan_state.current_row++];
+	}
+
+	return count;
+}
+
+//------------------------------------------------------------------------------
+// Modification
+//------------------------------------------------------------------------------
+
+void SparseIndex::AddPostings(unordered_map<int32_t, SparsePostingList> &other) {
+	auto lock = rwlock.GetExclusiveLock();
+	for (auto &entry : other) {
+		auto &source = entry.second;
+		auto &target = postings[entry.first];
+		target.row_ids.insert(target.row_ids.end(), source.row_ids.begin(), source.row_ids.end());
+		target.weights.insert(target.weights.end(), source.weights.begin(), source.weights.end());
+	}
+}
+
+void SparseIndex::FinalizePostings() {
+	auto lock = rwlock.GetExclusiveLock();
+	for (auto &entry : postings) {
+		entry.second.Finalize();
+	}
+}
+
+void SparseIndex::CommitDrop(IndexLock &index_lock) {
+	// Acquire an exclusive lock to drop the index
+	auto lock = rwlock.GetExclusiveLock();
+
+	postings.clear();
+	linked_block_allocator->Reset();
+	root_block_ptr.Clear();
+}
+
+void SparseIndex::Construct(DataChunk &input, Vector &row_ids) {
+	D_ASSERT(row_ids.GetType().InternalType() == ROW_TYPE);
+	D_ASSERT(logical_types[0] == input.data[0].GetType());
+
+	// Mark this index as dirty so we checkpoint it properly
+	is_dirty = true;
+
+	auto lock = rwlock.GetExclusiveLock();
+
+	// Append to the posting lists, and keep track of which lists have to be finalized afterwards
+	vector<SparsePostingList *> appended_lists;
+	ForEachPosting(input.data[0], row_ids, input.size(), [&](row_t row_id, int32_t dimension, float weight) {
+		auto &list = postings[dimension];
+		if (list.finalized_count == list.Count()) {
+			appended_lists.push_back(&list);
+		}
+		list.Append(row_id, weight);
+	});
+
+	for (auto list : appended_lists) {
+		list->Finalize();
+	}
+}
+
+void SparseIndex::Delete(IndexLock &lock, DataChunk &input, Vector &rowid_vec) {
+	// Mark this index as dirty so we checkpoint it properly
+	is_dirty = true;
+
+	DataChunk expression_result;
+	expression_result.Initialize(Allocator::DefaultAllocator(), logical_types);
+	ExecuteExpressions(input, expression_result);
+
+	// Gather the deleted row ids of every dimension
+	unordered_map<int32_t, vector<row_t>> deleted_rows;
+	ForEachPosting(expression_result.data[0], rowid_vec, input.size(),
+	               [&](row_t row_id, int32_t dimension, float weight) { deleted_rows[dimension].push_back(row_id); });
+
+	// For deleting from the index, we need an exclusive lock
+	auto _lock = rwlock.GetExclusiveLock();
+
+	for (auto &entry : deleted_rows) {
+		auto list = postings.find(entry.first);
+		if (list == postings.end()) {
+			continue;
+		}
+		std::sort(entry.second.begin(), entry.second.end());
+		list->second.Remove(entry.second);
+		if (list->second.Count() == 0) {
+			postings.erase(list);
+		}
+	}
+}
+
+ErrorData SparseIndex::Insert(IndexLock &lock, DataChunk &input, Vector &rowid_vec) {
+	Construct(input, rowid_vec);
+	return ErrorData {};
+}
+
+ErrorData SparseIndex::Append(IndexLock &lock, DataChunk &appended_data, Vector &row_identifiers) {
+	DataChunk expression_result;
+	expression_result.Initialize(Allocator::DefaultAllocator(), logical_types);
+
+	// first resolve the expressions for the index
+	ExecuteExpressions(appended_data, expression_result);
+
+	// now insert into the index
+	Construct(expression_result, row_identifiers);
+
+	return ErrorData {};
+}
+
+void SparseIndex::VerifyAppend(DataChunk &chunk) {
+	// There is nothing to verify here as we dont support constraints anyway
+}
+
+void SparseIndex::VerifyAppend(DataChunk &chunk, ConflictManager &conflict_manager) {
+	// There is nothing to verify here as we dont support constraints anyway
+}
+
+//------------------------------------------------------------------------------
+// Storage
+//------------------------------------------------------------------------------
+
+void SparseIndex::PersistToDisk() {
+	// Acquire an exclusive lock to persist the index
+	auto lock = rwlock.GetExclusiveLock();
+
+	// If there haven't been any changes, we don't need to rewrite the index again
+	if (!is_dirty) {
+		return;
+	}
+
+	if (root_block_ptr.Get() == 0) {
+		root_block_ptr = linked_block_allocator->New();
+	}
+
+	LinkedBlockWriter writer(*linked_block_allocator, root_block_ptr);
+	writer.Reset();
+
+	// The lists are stored one after another as (dimension, count, row ids, weights)
+	idx_t list_count = postings.size();
+	writer.WriteData(const_data_ptr_cast(&list_count), sizeof(idx_t));
+	for (auto &entry : postings) {
+		auto &list = entry.second;
+		D_ASSERT(list.finalized_count == list.Count());
+		idx_t count = list.Count();
+		writer.WriteData(const_data_ptr_cast(&entry.first), sizeof(int32_t));
+		writer.WriteData(const_data_ptr_cast(&count), sizeof(idx_t));
+		writer.WriteData(const_data_ptr_cast(list.row_ids.data()), count * sizeof(row_t));
+		writer.WriteData(const_data_ptr_cast(list.weights.data()), count * sizeof(float));
+	}
+
+	is_dirty = false;
+}
+
+IndexStorageInfo SparseIndex::GetStorageInfo(const bool get_buffers) {
+
+	PersistToDisk();
+
+	IndexStorageInfo info;
+	info.name = name;
+	info.root = root_block_ptr.Get();
+
+	if (!get_buffers) {
+		// use the partial block manager to serialize all allocator data
+		auto &block_manager = table_io_manager.GetIndexBlockManager();
+		PartialBlockManager partial_block_manager(block_manager, PartialBlockType::FULL_CHECKPOINT);
+		linked_block_allocator->SerializeBuffers(partial_block_manager);
+		partial_block_manager.FlushPartialBlocks();
+	} else {
+		info.buffers.push_back(linked_block_allocator->InitSerializationToWAL());
+	}
+
+	info.allocator_infos.push_back(linked_block_allocator->GetInfo());
+	return info;
+}
+
+idx_t SparseIndex::GetInMemorySize(IndexLock &state) {
+	auto lock = rwlock.GetSharedLock();
+	idx_t size = 0;
+	for (auto &entry : postings) {
+		size += sizeof(int32_t) + entry.second.GetSizeInBytes();
+	}
+	return size;
+}
+
+bool SparseIndex::MergeIndexes(IndexLock &state, BoundIndex &other_index) {
+	throw NotImplementedException("SparseIndex::MergeIndexes() not implemented");
+}
+
+void SparseIndex::Vacuum(IndexLock &state) {
+}
+
+void SparseIndex::CheckConstraintsForChunk(DataChunk &input, ConflictManager &conflict_manager) {
+	throw NotImplementedException("SparseIndex::CheckConstraintsForChunk() not implemented");
+}
+
+string SparseIndex::VerifyAndToString(IndexLock &state, const bool only_verify) {
+	throw NotImplementedException("SparseIndex::VerifyAndToString() not implemented");
+}
+
+//------------------------------------------------------------------------------
+// Register Index Type
+//------------------------------------------------------------------------------
+void SparseModule::RegisterIndex(DatabaseInstance &db) {
+
+	IndexType index_type;
+
+	index_type.name = SparseIndex::TYPE_NAME;
+	index_type.create_instance = [](CreateIndexInput &input) -> unique_ptr<BoundIndex> {
+		auto res = make_uniq<SparseIndex>(input.name, input.constraint_type, input.column_ids, input.table_io_manager,
+		                                  input.unbound_expressions, input.db, input.options, input.storage_info);
+		return std::move(res);
+	};
+
+	// Register the index type
+	db.config.GetIndexTypes().RegisterIndexType(index_type);
+}
+
+} // namespace duckdb
@@ -0,0 +1,145 @@
+#include "sparse/sparse_index_physical_create.hpp"
+
+#include "duckdb/catalog/catalog_entry/duck_index_entry.hpp"
+#include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/exception/transaction_exception.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/storage/storage_manager.hpp"
+#include "duckdb/storage/table_io_manager.hpp"
+#include "sparse/sparse_index.hpp"
+
+namespace duckdb {
+
+PhysicalCreateSparseIndex::PhysicalCreateSparseIndex(LogicalOperator &op, TableCatalogEntry &table,
+                                                     const vector<column_t> &column_ids,
+                                                     unique_ptr<CreateIndexInfo> info,
+                                                     vector<unique_ptr<Expression>> unbound_expressions,
+                                                     idx_t estimated_cardinality)
+    // Declare this operators as a EXTENSION operator
+    : PhysicalOperator(PhysicalOperatorType::EXTENSION, op.types, estimated_cardinality),
+      table(table.Cast<DuckTableEntry>()), info(std::move(info)), unbound_expressions(std::move(unbound_expressions)) {
+
+	// convert virtual column ids to storage column ids
+	for (auto &column_id : column_ids) {
+		storage_ids.push_back(table.GetColumns().LogicalToPhysical(LogicalIndex(column_id)).index);
+	}
+}
+
+//-------------------------------------------------------------
+// Global State
+//-------------------------------------------------------------
+class CreateSparseIndexGlobalState final : public GlobalSinkState {
+public:
+	//! Global index to be added to the table
+	unique_ptr<SparseIndex> global_index;
+};
+
+unique_ptr<GlobalSinkState> PhysicalCreateSparseIndex::GetGlobalSinkState(ClientContext &context) const {
+	auto gstate = make_uniq<CreateSparseIndexGlobalState>();
+
+	// Create the index
+	auto &storage = table.GetStorage();
+	auto &table_manager = TableIOManager::Get(storage);
+	auto &constraint_type = info->constraint_type;
+	auto &db = storage.db;
+	gstate->global_index = make_uniq<SparseIndex>(info->index_name, constraint_type, storage_ids, table_manager,
+	                                              unbound_expressions, db, info->options, IndexStorageInfo());
+
+	return std::move(gstate);
+}
+
+//-------------------------------------------------------------
+// Local State
+//-------------------------------------------------------------
+class CreateSparseIndexLocalState final : public LocalSinkState {
+public:
+	//! The postings gathered by this thread, by dimension
+	unordered_map<int32_t, SparsePostingList> postings;
+};
+
+unique_ptr<LocalSinkState> PhysicalCreateSparseIndex::GetLocalSinkState(ExecutionContext &context) const {
+	return make_uniq<CreateSparseIndexLocalState>();
+}
+
+//-------------------------------------------------------------
+// Sink
+//-------------------------------------------------------------
+
+SinkResultType PhysicalCreateSparseIndex::Sink(ExecutionContext &context, DataChunk &chunk,
+                                               OperatorSinkInput &input) const {
+
+	auto &lstate = input.local_state.Cast<CreateSparseIndexLocalState>();
+	SparseIndex::ForEachPosting(chunk.data[0], chunk.data[1], chunk.size(),
+	                            [&](row_t row_id, int32_t dimension, float weight) {
+		                            lstate.postings[dimension].Append(row_id, weight);
+	                            });
+	return SinkResultType::NEED_MORE_INPUT;
+}
+
+//-------------------------------------------------------------
+// Combine
+//-------------------------------------------------------------
+SinkCombineResultType PhysicalCreateSparseIndex::Combine(ExecutionContext &context,
+                                                         OperatorSinkCombineInput &input) const {
+	auto &gstate = input.global_state.Cast<CreateSparseIndexGlobalState>();
+	auto &lstate = input.local_state.Cast<CreateSparseIndexLocalState>();
+
+	gstate.global_index->AddPostings(lstate.postings);
+	lstate.postings.clear();
+
+	return SinkCombineResultType::FINISHED;
+}
+
+//-------------------------------------------------------------
+// Finalize
+//-------------------------------------------------------------
+SinkFinalizeType PhysicalCreateSparseIndex::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                                     OperatorSinkFinalizeInput &input) const {
+
+	auto &gstate = input.global_state.Cast<CreateSparseIndexGlobalState>();
+
+	// The threads each gathered a part of the table, sort their postings into the lists
+	gstate.global_index->FinalizePostings();
+
+	// Mark the index as dirty
+	gstate.global_index->SetDirty();
+
+	auto &storage = table.GetStorage();
+
+	// If not in memory, persist the index to disk
+	if (!storage.db.GetStorageManager().InMemory()) {
+		// Finalize the index
+		gstate.global_index->PersistToDisk();
+	}
+
+	if (!storage.IsRoot()) {
+		throw TransactionException("Cannot create index on non-root transaction");
+	}
+
+	// Create the index entry in the catalog
+	auto &schema = table.schema;
+	info->column_ids = storage_ids;
+	const auto index_entry = schema.CreateIndex(context, *info, table).get();
+	if (!index_entry) {
+		D_ASSERT(info->on_conflict == OnCreateConflict::IGNORE_ON_CONFLICT);
+		// index already exists, but error ignored because of IF NOT EXISTS
+		return SinkFinalizeType::READY;
+	}
+
+	// Get the entry as a DuckIndexEntry
+	auto &duck_index = index_entry->Cast<DuckIndexEntry>();
+	duck_index.initial_index_size = gstate.global_index->Cast<BoundIndex>().GetInMemorySize();
+	duck_index.info = make_uniq<IndexDataTableInfo>(storage.GetDataTableInfo(), duck_index.name);
+	for (auto &parsed_expr : info->parsed_expressions) {
+		duck_index.parsed_expressions.push_back(parsed_expr->Copy());
+	}
+
+	// Finally add it to storage
+	storage.AddIndex(std::move(gstate.global_index));
+
+	return SinkFinalizeType::READY;
+}
+
+} // namespace duckdb
@@ -0,0 +1,260 @@
+#include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/catalog/dependency_list.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/function/function_set.hpp"
+#include "duckdb/optimizer/matcher/expression_matcher.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/storage/table/scan_state.hpp"
+#include "duckdb/transaction/duck_transaction.hpp"
+#include "duckdb/transaction/local_storage.hpp"
+#include "duckdb/main/extension_util.hpp"
+#include "duckdb/catalog/catalog_entry/duck_index_entry.hpp"
+#include "duckdb/storage/data_table.hpp"
+
+#include "sparse/sparse.hpp"
+#include "sparse/sparse_index.hpp"
+#include "sparse/sparse_index_scan.hpp"
+
+namespace duckdb {
+
+BindInfo SparseIndexScanBindInfo(const optional_ptr<FunctionData> bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<SparseIndexScanBindData>();
+	return BindInfo(bind_data.table);
+}
+
+//-------------------------------------------------------------------------
+// Global State
+//-------------------------------------------------------------------------
+struct SparseIndexScanGlobalState : public GlobalTableFunctionState {
+	ColumnFetchState fetch_state;
+	TableScanState local_storage_state;
+	vector<storage_t> column_ids;
+
+	// Index scan state
+	unique_ptr<IndexScanState> index_state;
+	Vector row_ids = Vector(LogicalType::ROW_TYPE);
+	bool index_exhausted = false;
+
+	// The index only returns rows that share a dimension with the query. If fewer than "limit" of them score at least
+	// 0, the rows that score 0 (and after them, the NULL rows) rank above the rest, so they are taken from a scan of
+	// the table. The top-n operator above this scan orders all rows by their actual score.
+	unordered_set<row_t> index_rows;
+	unordered_set<int32_t> query_dimensions;
+	idx_t zero_rows_left = 0;
+	idx_t null_rows_left = 0;
+	TableScanState table_scan_state;
+	DataChunk scan_chunk;
+};
+
+static unique_ptr<GlobalTableFunctionState> SparseIndexScanInitGlobal(ClientContext &context,
+                                                                      TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<SparseIndexScanBindData>();
+
+	auto result = make_uniq<SparseIndexScanGlobalState>();
+
+	// Setup the scan state for the local storage
+	auto &local_storage = LocalStorage::Get(context, bind_data.table.catalog);
+	result->column_ids.reserve(input.column_ids.size());
+
+	// Figure out the storage column ids
+	for (auto &id : input.column_ids) {
+		storage_t col_id = id;
+		if (id != DConstants::INVALID_INDEX) {
+			col_id = bind_data.table.GetColumn(LogicalIndex(id)).StorageOid();
+		}
+		result->column_ids.push_back(col_id);
+	}
+
+	// Initialize the storage scan state
+	result->local_storage_state.Initialize(result->column_ids, input.filters.get());
+	local_storage.InitializeScan(bind_data.table.GetStorage(), result->local_storage_state.local_state, input.filters);
+
+	// Initialize the scan state for the index
+	auto &sparse_index = bind_data.index.Cast<SparseIndex>();
+	result->index_state = sparse_index.InitializeScan(bind_data.query, bind_data.limit);
+
+	// Find out how many rows scoring 0 could make it into the results
+	auto &index_state = result->index_state->Cast<SparseIndexScanState>();
+	idx_t non_negative_count = 0;
+	for (idx_t i = 0; i < index_state.total_rows; i++) {
+		result->index_rows.insert(index_state.row_ids[i]);
+		if (index_state.scores[i] >= 0) {
+			non_negative_count++;
+		}
+	}
+	if (non_negative_count < bind_data.limit) {
+		result->zero_rows_left = bind_data.limit - non_negative_count;
+		result->null_rows_left = bind_data.limit;
+		for (auto &entry : bind_data.query) {
+			result->query_dimensions.insert(entry.first);
+		}
+
+		// Scan the projected columns followed by the indexed column and the row ids
+		auto &transaction = DuckTransaction::Get(context, bind_data.table.catalog);
+		vector<column_t> scan_ids(result->column_ids.begin(), result->column_ids.end());
+		scan_ids.push_back(sparse_index.column_ids[0]);
+		scan_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+		bind_data.table.GetStorage().InitializeScan(transaction, result->table_scan_state, scan_ids);
+
+		vector<LogicalType> scan_types;
+		for (auto &id : input.column_ids) {
+			scan_types.push_back(id == DConstants::INVALID_INDEX ? LogicalType::ROW_TYPE
+			                                                     : bind_data.table.GetColumn(LogicalIndex(id)).Type());
+		}
+		scan_types.push_back(sparse_index.logical_types[0]);
+		scan_types.push_back(LogicalType::ROW_TYPE);
+		result->scan_chunk.Initialize(context, scan_types);
+	}
+
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Execute
+//-------------------------------------------------------------------------
+static void SparseIndexScanExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+
+	auto &bind_data = data_p.bind_data->Cast<SparseIndexScanBindData>();
+	auto &state = data_p.global_state->Cast<SparseIndexScanGlobalState>();
+	auto &transaction = DuckTransaction::Get(context, bind_data.table.catalog);
+
+	auto &storage = bind_data.table.GetStorage();
+
+	// Scan the index for row id's
+	while (!state.index_exhausted) {
+		auto row_count = bind_data.index.Cast<SparseIndex>().Scan(*state.index_state, state.row_ids);
+		if (row_count == 0) {
+			state.index_exhausted = true;
+			break;
+		}
+
+		// Fetch the data from the local storage given the row ids, rows that are not visible to us are skipped
+		storage.Fetch(transaction, output, state.column_ids, state.row_ids, row_count, state.fetch_state);
+		if (output.size() != 0) {
+			return;
+		}
+	}
+
+	// Fill up the results with the rows the index did not return that score 0, or NULL
+	const auto column_count = state.column_ids.size();
+	SelectionVector sel(STANDARD_VECTOR_SIZE);
+	while (state.zero_rows_left != 0 || state.null_rows_left != 0) {
+		state.scan_chunk.Reset();
+		storage.Scan(transaction, state.scan_chunk, state.table_scan_state);
+		if (state.scan_chunk.size() == 0) {
+			break;
+		}
+		auto &vec_vec = state.scan_chunk.data[column_count];
+		auto &row_id_vec = state.scan_chunk.data[column_count + 1];
+
+		// Find the rows that share a dimension with the query, the index returned the best of them already
+		unordered_set<row_t> overlapping;
+		SparseIndex::ForEachPosting(vec_vec, row_id_vec, state.scan_chunk.size(),
+		                            [&](row_t row_id, int32_t dimension, float weight) {
+			                            if (state.query_dimensions.count(dimension) != 0) {
+				                            overlapping.insert(row_id);
+			                            }
+		                            });
+
+		UnifiedVectorFormat vec_format;
+		vec_vec.ToUnifiedFormat(state.scan_chunk.size(), vec_format);
+		UnifiedVectorFormat row_id_format;
+		row_id_vec.ToUnifiedFormat(state.scan_chunk.size(), row_id_format);
+		auto row_id_data = UnifiedVectorFormat::GetData<row_t>(row_id_format);
+
+		idx_t count = 0;
+		for (idx_t i = 0; i < state.scan_chunk.size(); i++) {
+			auto row_id = row_id_data[row_id_format.sel->get_index(i)];
+			if (state.index_rows.count(row_id) != 0 || overlapping.count(row_id) != 0) {
+				continue;
+			}
+			auto &rows_left = vec_format.validity.RowIsValid(vec_format.sel->get_index(i)) ? state.zero_rows_left
+			                                                                               : state.null_rows_left;
+			if (rows_left == 0) {
+				continue;
+			}
+			rows_left--;
+			sel.set_index(count++, i);
+		}
+		if (count == 0) {
+			continue;
+		}
+		for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+			output.data[col_idx].Slice(state.scan_chunk.data[col_idx], sel, count);
+		}
+		output.SetCardinality(count);
+		return;
+	}
+	output.SetCardinality(0);
+}
+
+//-------------------------------------------------------------------------
+// Statistics
+//-------------------------------------------------------------------------
+static unique_ptr<BaseStatistics> SparseIndexScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                                            column_t column_id) {
+	auto &bind_data = bind_data_p->Cast<SparseIndexScanBindData>();
+	auto &local_storage = LocalStorage::Get(context, bind_data.table.catalog);
+	if (local_storage.Find(bind_data.table.GetStorage())) {
+		// we don't emit any statistics for tables that have outstanding transaction-local data
+		return nullptr;
+	}
+	return bind_data.table.GetStatistics(context, column_id);
+}
+
+//-------------------------------------------------------------------------
+// Dependency
+//-------------------------------------------------------------------------
+void SparseIndexScanDependency(LogicalDependencyList &entries, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<SparseIndexScanBindData>();
+	// The index belongs to the table, and dropping it changes the catalog, which makes bound plans rebind
+	entries.AddDependency(bind_data.table);
+}
+
+//-------------------------------------------------------------------------
+// Cardinality
+//-------------------------------------------------------------------------
+unique_ptr<NodeStatistics> SparseIndexScanCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<SparseIndexScanBindData>();
+	return make_uniq<NodeStatistics>(bind_data.limit, bind_data.limit);
+}
+
+//-------------------------------------------------------------------------
+// ToString
+//-------------------------------------------------------------------------
+static string SparseIndexScanToString(const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<SparseIndexScanBindData>();
+	return bind_data.table.name + " (SPARSE INDEX SCAN : " + bind_data.index.GetIndexName() + ")";
+}
+
+//-------------------------------------------------------------------------
+// Get Function
+//-------------------------------------------------------------------------
+TableFunction SparseIndexScanFunction::GetFunction() {
+	TableFunction func("sparse_index_scan", {}, SparseIndexScanExecute);
+	func.init_local = nullptr;
+	func.init_global = SparseIndexScanInitGlobal;
+	func.statistics = SparseIndexScanStatistics;
+	func.dependency = SparseIndexScanDependency;
+	func.cardinality = SparseIndexScanCardinality;
+	func.pushdown_complex_filter = nullptr;
+	func.to_string = SparseIndexScanToString;
+	func.table_scan_progress = nullptr;
+	func.get_batch_index = nullptr;
+	func.projection_pushdown = true;
+	func.filter_pushdown = false;
+	func.get_bind_info = SparseIndexScanBindInfo;
+
+	return func;
+}
+
+//-------------------------------------------------------------------------
+// Register
+//-------------------------------------------------------------------------
+void SparseModule::RegisterIndexScan(DatabaseInstance &db) {
+	ExtensionUtil::RegisterFunction(db, SparseIndexScanFunction::GetFunction());
+}
+
+} // namespace duckdb
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/operator/logical_create_index.hpp"
+#include "duckdb/parser/parsed_data/create_index_info.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+
+#include "sparse/sparse.hpp"
+#include "sparse/sparse_index.hpp"
+#include "sparse/sparse_index_logical_create.hpp"
+
+namespace duckdb {
+
+//-----------------------------------------------------------------------------
+// Plan rewriter
+//-----------------------------------------------------------------------------
+class SparseIndexInsertionRewriter : public OptimizerExtension {
+public:
+	SparseIndexInsertionRewriter() {
+		optimize_function = SparseIndexInsertionRewriter::Optimize;
+	}
+
+	static void TryOptimize(ClientContext &context, unique_ptr<LogicalOperator> &plan) {
+		auto &op = *plan;
+
+		// Look for a CREATE INDEX operator
+		if (op.type != LogicalOperatorType::LOGICAL_CREATE_INDEX) {
+			return;
+		}
+		auto &create_index = op.Cast<LogicalCreateIndex>();
+
+		if (create_index.info->index_type != SparseIndex::TYPE_NAME) {
+			// Not the index type we are looking for
+			return;
+		}
+
+		Value enable_persistence;
+		context.TryGetCurrentSetting("sparse_enable_experimental_persistence", enable_persistence);
+
+		auto is_disk_db = !create_index.table.GetStorage().db.GetStorageManager().InMemory();
+		auto is_persistence_disabled = !enable_persistence.GetValue<bool>();
+
+		if (is_disk_db && is_persistence_disabled) {
+			throw BinderException("SPARSE indexes can only be created in in-memory databases, or when the "
+			                      "configuration option 'sparse_enable_experimental_persistence' is set to true.");
+		}
+
+		// Verify the options, there are none yet
+		auto &options = create_index.info->options;
+		if (!options.empty()) {
+			throw BinderException("Unknown option for SPARSE index: '%s'", options.begin()->first);
+		}
+
+		// Verify the expression type
+		if (create_index.expressions.size() != 1) {
+			throw BinderException("SPARSE indexes can only be created over a single column of keys.");
+		}
+		if (!SparseIndex::IsSparseVectorType(create_index.expressions[0]->return_type)) {
+			throw BinderException("SPARSE index keys must be of type MAP(INTEGER, FLOAT)");
+		}
+		// Scans are matched to the index by the column that is scored
+		if (create_index.expressions[0]->type != ExpressionType::BOUND_COLUMN_REF) {
+			throw BinderException("SPARSE indexes can only be created over a plain column");
+		}
+
+		// We have a create index operator for our index
+		// We can replace this with a operator that creates the index
+		auto physical_create_index = make_uniq<LogicalCreateSparseIndex>(
+		    std::move(create_index.info), std::move(create_index.expressions), create_index.table);
+
+		// Move the children
+		physical_create_index->children = std::move(create_index.children);
+
+		// Replace the operator
+		plan = std::move(physical_create_index);
+	}
+
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+
+		TryOptimize(input.context, plan);
+
+		// Recursively traverse the children
+		for (auto &child : plan->children) {
+			Optimize(input, child);
+		}
+	};
+};
+
+//-------------------------------------------------------------
+// Register
+//-------------------------------------------------------------
+void SparseModule::RegisterPlanIndexCreate(DatabaseInstance &db) {
+	// Register the optimizer extension
+	db.config.AddExtensionOption("sparse_enable_experimental_persistence",
+	                             "experimental: enable creating SPARSE indexes in persistent databases",
+	                             LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	db.config.optimizer_extensions.push_back(SparseIndexInsertionRewriter());
+}
+
+} // namespace duckdb
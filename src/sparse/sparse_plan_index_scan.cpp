@@ -0,0 +1,195 @@
+#include "duckdb/catalog/catalog_entry/duck_table_entry.hpp"
+#include "duckdb/optimizer/optimizer_extension.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_top_n.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "sparse/sparse.hpp"
+#include "sparse/sparse_index.hpp"
+#include "sparse/sparse_index_scan.hpp"
+
+namespace duckdb {
+
+//-----------------------------------------------------------------------------
+// Plan rewriter
+//-----------------------------------------------------------------------------
+class SparseIndexScanOptimizer : public OptimizerExtension {
+public:
+	SparseIndexScanOptimizer() {
+		optimize_function = SparseIndexScanOptimizer::Optimize;
+	}
+
+	static bool TryOptimize(ClientContext &context, unique_ptr<LogicalOperator> &plan) {
+		// Look for a TopN operator
+		auto &op = *plan;
+
+		if (op.type != LogicalOperatorType::LOGICAL_TOP_N) {
+			return false;
+		}
+
+		// Look for a expression that is a score expression
+		auto &top_n = op.Cast<LogicalTopN>();
+
+		if (top_n.orders.size() != 1) {
+			// We can only optimize if there is a single order by expression right now
+			return false;
+		}
+
+		auto &order = top_n.orders[0];
+
+		if (order.type != OrderType::DESCENDING) {
+			// We can only optimize if the order by expression is descending, the best matches score the highest
+			return false;
+		}
+
+		if (order.expression->type != ExpressionType::BOUND_COLUMN_REF) {
+			// The expression has to reference the child operator (a projection with the score function)
+			return false;
+		}
+		auto &bound_column_ref = order.expression->Cast<BoundColumnRefExpression>();
+
+		// find the expression that is referenced
+		auto &immediate_child = top_n.children[0];
+		if (immediate_child->type != LogicalOperatorType::LOGICAL_PROJECTION) {
+			// The child has to be a projection
+			return false;
+		}
+		auto &projection = immediate_child->Cast<LogicalProjection>();
+		auto projection_index = bound_column_ref.binding.column_index;
+
+		if (projection.expressions[projection_index]->type != ExpressionType::BOUND_FUNCTION) {
+			// The expression has to be a function
+			return false;
+		}
+		auto &bound_function = projection.expressions[projection_index]->Cast<BoundFunctionExpression>();
+		if (!SparseIndex::IsScoreFunction(bound_function.function.name)) {
+			// We can only optimize if the order by expression is a score function
+			return false;
+		}
+
+		// Figure out the query vector, the other argument has to be a column
+		Value target_value;
+		optional_ptr<Expression> column_expr;
+		if (bound_function.children[0]->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+			target_value = bound_function.children[0]->Cast<BoundConstantExpression>().value;
+			column_expr = bound_function.children[1].get();
+		} else if (bound_function.children[1]->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+			target_value = bound_function.children[1]->Cast<BoundConstantExpression>().value;
+			column_expr = bound_function.children[0].get();
+		} else {
+			// We can only optimize if one of the children is a constant
+			return false;
+		}
+		if (column_expr->type != ExpressionType::BOUND_COLUMN_REF) {
+			return false;
+		}
+		auto &column_binding = column_expr->Cast<BoundColumnRefExpression>().binding;
+
+		if (!SparseIndex::IsSparseVectorType(target_value.type())) {
+			// We can only optimize if the constant is a sparse vector
+			return false;
+		}
+
+		// find any direct child or grandchild that is a get
+		auto child = top_n.children[0].get();
+		while (child->type != LogicalOperatorType::LOGICAL_GET) {
+			if (child->children.size() != 1) {
+				// Either 0 or more than 1 child. The rows of a join are ranked after joining, so the index of one of
+				// its sides cannot produce them
+				return false;
+			}
+			child = child->children[0].get();
+		}
+
+		auto &get = child->Cast<LogicalGet>();
+		// Check if the get is a table scan
+		if (get.function.name != "seq_scan") {
+			return false;
+		}
+
+		// The column has to come straight from the scan
+		if (column_binding.table_index != get.table_index) {
+			return false;
+		}
+		auto &get_column_ids = get.GetColumnIds();
+		if (column_binding.column_index >= get_column_ids.size()) {
+			return false;
+		}
+		auto column_id = get_column_ids[column_binding.column_index];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			return false;
+		}
+
+		// We have a top-n operator on top of a table scan
+		// We can replace the function with a custom index scan (if the table has a custom index)
+
+		// Get the table
+		auto &table = *get.GetTable();
+		if (!table.IsDuckTable()) {
+			// We can only replace the scan if the table is a duck table
+			return false;
+		}
+
+		auto &duck_table = table.Cast<DuckTableEntry>();
+		auto &table_info = *table.GetStorage().GetDataTableInfo();
+		auto storage_id = duck_table.GetColumn(LogicalIndex(column_id)).StorageOid();
+
+		// Find the index
+		unique_ptr<SparseIndexScanBindData> bind_data = nullptr;
+		table_info.GetIndexes().BindAndScan<SparseIndex>(context, table_info, [&](SparseIndex &index_entry) {
+			if (index_entry.column_ids.size() != 1 || index_entry.column_ids[0] != storage_id) {
+				// The index is not over the column that is scored
+				return false;
+			}
+
+			// Create the bind data for this index
+			auto query = SparseIndex::GetSparseVector(target_value);
+			bind_data = make_uniq<SparseIndexScanBindData>(duck_table, index_entry, top_n.limit, std::move(query));
+			return true;
+		});
+
+		if (!bind_data) {
+			// No index found
+			return false;
+		}
+
+		// Replace the scan with our custom index scan function
+
+		get.function = SparseIndexScanFunction::GetFunction();
+		auto cardinality = get.function.cardinality(context, bind_data.get());
+		get.has_estimated_cardinality = cardinality->has_estimated_cardinality;
+		get.estimated_cardinality = cardinality->estimated_cardinality;
+		get.bind_data = std::move(bind_data);
+
+		// Keep the TopN operator: the scan returns the best rows the index finds followed by the rows scoring 0 that
+		// may rank above them, and the TopN orders them by their actual score
+		return true;
+	}
+
+	static bool OptimizeChildren(ClientContext &context, unique_ptr<LogicalOperator> &plan) {
+
+		auto ok = TryOptimize(context, plan);
+		// Recursively optimize the children
+		for (auto &child : plan->children) {
+			ok |= OptimizeChildren(context, child);
+		}
+		return ok;
+	}
+
+	static void Optimize(OptimizerExtensionInput &input, unique_ptr<LogicalOperator> &plan) {
+		OptimizeChildren(input.context, plan);
+	}
+};
+
+//-----------------------------------------------------------------------------
+// Register
+//-----------------------------------------------------------------------------
+void SparseModule::RegisterPlanIndexScan(DatabaseInstance &db) {
+	// Register the optimizer extension
+	db.config.optimizer_extensions.push_back(SparseIndexScanOptimizer());
+}
+
+} // namespace duckdb
@@ -0,0 +1,236 @@
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/main/extension_util.hpp"
+
+#include "vecs/vecs.hpp"
+
+namespace duckdb {
+
+// The fvecs, ivecs and bvecs formats store every vector as a little-endian int32 with the number of dimensions,
+// followed by the components as float32, int32 or uint8 respectively.
+enum class VecsFormat : uint8_t { FVECS, IVECS, BVECS };
+
+static LogicalType GetElementType(VecsFormat format) {
+	switch (format) {
+	case VecsFormat::FVECS:
+		return LogicalType::FLOAT;
+	case VecsFormat::IVECS:
+		return LogicalType::INTEGER;
+	case VecsFormat::BVECS:
+		return LogicalType::UTINYINT;
+	default:
+		throw InternalException("Unknown vecs format");
+	}
+}
+
+//-------------------------------------------------------------------------
+// Bind
+//-------------------------------------------------------------------------
+struct ReadVecsBindData : public TableFunctionData {
+	string function_name;
+	string file_path;
+	//! The number of components of every vector
+	idx_t dimensions = 0;
+	//! The size of a single component in bytes
+	idx_t element_size = 0;
+	//! The number of vectors in the file
+	idx_t rows = 0;
+
+	idx_t RecordSize() const {
+		return sizeof(int32_t) + dimensions * element_size;
+	}
+};
+
+template <VecsFormat FORMAT>
+static unique_ptr<FunctionData> ReadVecsBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<ReadVecsBindData>();
+	result->function_name = input.table_function.name;
+	if (input.inputs[0].IsNull()) {
+		throw BinderException("%s: the path cannot be NULL", result->function_name);
+	}
+	result->file_path = input.inputs[0].GetValue<string>();
+
+	auto element_type = GetElementType(FORMAT);
+	result->element_size = GetTypeIdSize(element_type.InternalType());
+
+	// The first vector tells us the number of dimensions, all the other vectors have to match it
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(result->file_path, FileFlags::FILE_FLAGS_READ);
+	auto file_size = handle->GetFileSize();
+	if (file_size < sizeof(int32_t)) {
+		throw InvalidInputException("%s: '%s' does not contain any vectors", result->function_name,
+		                            result->file_path);
+	}
+	int32_t dimensions;
+	handle->Read(&dimensions, sizeof(int32_t), 0);
+	if (dimensions <= 0 || static_cast<idx_t>(dimensions) > ArrayType::MAX_ARRAY_SIZE) {
+		throw InvalidInputException("%s: '%s' starts with an invalid number of dimensions: %d",
+		                            result->function_name, result->file_path, dimensions);
+	}
+	result->dimensions = static_cast<idx_t>(dimensions);
+	if (file_size % result->RecordSize() != 0) {
+		throw InvalidInputException(
+		    "%s: the size of '%s' is not a multiple of the size of a %llu-dimensional vector, the file is truncated",
+		    result->function_name, result->file_path, result->dimensions);
+	}
+	result->rows = file_size / result->RecordSize();
+
+	// The position of the vector in the file, which the ids in ivecs ground truth files refer to
+	names.emplace_back("id");
+	return_types.emplace_back(LogicalType::BIGINT);
+	names.emplace_back("vec");
+	return_types.emplace_back(LogicalType::ARRAY(element_type, result->dimensions));
+
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Global State
+//-------------------------------------------------------------------------
+struct ReadVecsGlobalState : public GlobalTableFunctionState {
+	unique_ptr<FileHandle> handle;
+	//! The next batch of vectors to read
+	atomic<idx_t> next_batch;
+	idx_t batch_count = 0;
+	vector<column_t> column_ids;
+
+	idx_t MaxThreads() const override {
+		return MaxValue<idx_t>(batch_count, 1);
+	}
+};
+
+static unique_ptr<GlobalTableFunctionState> ReadVecsInitGlobal(ClientContext &context, TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<ReadVecsBindData>();
+	auto result = make_uniq<ReadVecsGlobalState>();
+
+	// Every thread reads its own batches of vectors at their offset in the file
+	auto &fs = FileSystem::GetFileSystem(context);
+	result->handle =
+	    fs.OpenFile(bind_data.file_path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_PARALLEL_ACCESS);
+	result->next_batch = 0;
+	result->batch_count = (bind_data.rows + STANDARD_VECTOR_SIZE - 1) / STANDARD_VECTOR_SIZE;
+	result->column_ids = input.column_ids;
+
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Local State
+//-------------------------------------------------------------------------
+struct ReadVecsLocalState : public LocalTableFunctionState {
+	//! The raw records of the current batch, including the dimensions in front of every vector
+	unsafe_unique_array<data_t> buffer;
+	idx_t batch_index = 0;
+};
+
+static unique_ptr<LocalTableFunctionState> ReadVecsInitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+                                                             GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<ReadVecsBindData>();
+	auto result = make_uniq<ReadVecsLocalState>();
+	result->buffer = make_unsafe_uniq_array<data_t>(bind_data.RecordSize() * STANDARD_VECTOR_SIZE);
+	return std::move(result);
+}
+
+//-------------------------------------------------------------------------
+// Execute
+//-------------------------------------------------------------------------
+static void ReadVecsExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<ReadVecsBindData>();
+	auto &gstate = data_p.global_state->Cast<ReadVecsGlobalState>();
+	auto &lstate = data_p.local_state->Cast<ReadVecsLocalState>();
+
+	const auto batch_index = gstate.next_batch++;
+	if (batch_index >= gstate.batch_count) {
+		output.SetCardinality(0);
+		return;
+	}
+	lstate.batch_index = batch_index;
+
+	const auto start_row = batch_index * STANDARD_VECTOR_SIZE;
+	const auto count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, bind_data.rows - start_row);
+	const auto record_size = bind_data.RecordSize();
+	gstate.handle->Read(lstate.buffer.get(), count * record_size, start_row * record_size);
+
+	for (idx_t i = 0; i < count; i++) {
+		auto dimensions = Load<int32_t>(lstate.buffer.get() + i * record_size);
+		if (dimensions != static_cast<int32_t>(bind_data.dimensions)) {
+			throw InvalidInputException("%s: vector %llu in '%s' has %d dimensions, expected %llu",
+			                            bind_data.function_name, start_row + i, bind_data.file_path, dimensions,
+			                            bind_data.dimensions);
+		}
+	}
+
+	const auto vector_size = bind_data.dimensions * bind_data.element_size;
+	for (idx_t col_idx = 0; col_idx < gstate.column_ids.size(); col_idx++) {
+		auto &result = output.data[col_idx];
+		if (gstate.column_ids[col_idx] == 1) {
+			// The components are stored back to back in the child vector of the array,
+			// so every vector is copied straight out of the read buffer
+			auto child_data = FlatVector::GetData(ArrayVector::GetEntry(result));
+			for (idx_t i = 0; i < count; i++) {
+				memcpy(child_data + i * vector_size, lstate.buffer.get() + i * record_size + sizeof(int32_t),
+				       vector_size);
+			}
+		} else {
+			// The id column, also used for the row id when only counting
+			auto id_data = FlatVector::GetData<int64_t>(result);
+			for (idx_t i = 0; i < count; i++) {
+				id_data[i] = static_cast<int64_t>(start_row + i);
+			}
+		}
+	}
+	output.SetCardinality(count);
+}
+
+//-------------------------------------------------------------------------
+// Batch Index
+//-------------------------------------------------------------------------
+static idx_t ReadVecsGetBatchIndex(ClientContext &context, const FunctionData *bind_data_p,
+                                   LocalTableFunctionState *local_state, GlobalTableFunctionState *global_state) {
+	auto &lstate = local_state->Cast<ReadVecsLocalState>();
+	return lstate.batch_index;
+}
+
+//-------------------------------------------------------------------------
+// Progress
+//-------------------------------------------------------------------------
+static double ReadVecsProgress(ClientContext &context, const FunctionData *bind_data_p,
+                               const GlobalTableFunctionState *global_state) {
+	auto &gstate = global_state->Cast<ReadVecsGlobalState>();
+	if (gstate.batch_count == 0) {
+		return 100;
+	}
+	auto batches_read = MinValue<idx_t>(gstate.next_batch.load(), gstate.batch_count);
+	return 100.0 * static_cast<double>(batches_read) / static_cast<double>(gstate.batch_count);
+}
+
+//-------------------------------------------------------------------------
+// Cardinality
+//-------------------------------------------------------------------------
+static unique_ptr<NodeStatistics> ReadVecsCardinality(ClientContext &context, const FunctionData *bind_data_p) {
+	auto &bind_data = bind_data_p->Cast<ReadVecsBindData>();
+	return make_uniq<NodeStatistics>(bind_data.rows, bind_data.rows);
+}
+
+//-------------------------------------------------------------------------
+// Register
+//-------------------------------------------------------------------------
+template <VecsFormat FORMAT>
+static TableFunction GetReadVecsFunction(const string &name) {
+	TableFunction func(name, {LogicalType::VARCHAR}, ReadVecsExecute, ReadVecsBind<FORMAT>, ReadVecsInitGlobal,
+	                   ReadVecsInitLocal);
+	func.get_batch_index = ReadVecsGetBatchIndex;
+	func.table_scan_progress = ReadVecsProgress;
+	func.cardinality = ReadVecsCardinality;
+	func.projection_pushdown = true;
+	return func;
+}
+
+void VecsModule::RegisterReadVecs(DatabaseInstance &db) {
+	ExtensionUtil::RegisterFunction(db, GetReadVecsFunction<VecsFormat::FVECS>("read_fvecs"));
+	ExtensionUtil::RegisterFunction(db, GetReadVecsFunction<VecsFormat::IVECS>("read_ivecs"));
+	ExtensionUtil::RegisterFunction(db, GetReadVecsFunction<VecsFormat::BVECS>("read_bvecs"));
+}
+
+} // namespace duckdb
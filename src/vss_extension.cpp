@@ -9,12 +9,21 @@
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
 
 #include "hnsw/hnsw.hpp"
+#include "hybrid/hybrid.hpp"
+#include "sparse/sparse.hpp"
+#include "vecs/vecs.hpp"
 
 namespace duckdb {
 
 static void LoadInternal(DatabaseInstance &instance) {
 	// Register the HNSW index module
 	HNSWModule::Register(instance);
+	// Register the sparse vector index module
+	SparseModule::Register(instance);
+	// Register the hybrid search functions, which combine the two
+	HybridModule::Register(instance);
+	// Register the readers for fvecs, ivecs and bvecs files
+	VecsModule::Register(instance);
 }
 
 void VssExtension::Load(DuckDB &db) {